@@ -5,6 +5,15 @@
 
 namespace geotree{
 
+  void AlgoBase::AddMemoryUsage(MemoryUsage_t& usage) const {
+
+    for (auto const& c : _corr_v){
+      usage.scratch += MemoryUsage_t::kMapNodeOverhead + sizeof(c);
+      usage.scratch += c.second.HeapBytes();
+    }
+
+    return;
+  }
 
 }
 
@@ -17,6 +17,7 @@
 #include "Correlation.h"
 #include "NodeCollection.h"
 #include "Node.h"
+#include "Logger.h"
 #include <vector>
 #include "string.h"
 
@@ -26,10 +27,10 @@ namespace geotree{
 
   public:
     
-    AlgoBase() { _name=""; _verbose = false; }
+    AlgoBase() { _name=""; _log_level = -1; }
 
     /// Constructor which syncs node collection for the algorithm
-    AlgoBase(NodeCollection* coll) { _name=""; _coll = coll; _verbose = false; }
+    AlgoBase(NodeCollection* coll) { _name=""; _coll = coll; _log_level = -1; }
 
     virtual ~AlgoBase(){}
 
@@ -39,14 +40,15 @@ namespace geotree{
     /// clear correlations. To be called every time aglorithm is applied to a node
     virtual void ClearCorrelations() { _corr_v.clear(); }
 
-    /// set verbosity
-    void SetVerbose(bool on) { _verbose = on; }
+    /// add the memory held by the algorithm's scratch correlations to a report
+    void AddMemoryUsage(MemoryUsage_t& usage) const;
+
+    /// set verbosity of this algorithm only: its messages are
+    /// written at this level while it works (see Logger::Scope)
+    void SetVerbose(bool on) { _log_level = on ? msg::kDEBUG : msg::kNORMAL; }
 
   protected:
 
-    // verbosity flag
-    bool _verbose;
-    
     // Algo's name
     std::string _name;
 
@@ -54,8 +56,11 @@ namespace geotree{
     // connects a pair of nodes to a correlation type
     std::map< std::pair<NodeID_t, NodeID_t>, geotree::Correlation> _corr_v;
 
-    // pointer to collection reference
-    NodeCollection* _coll;
+    // pointer to collection reference (algorithms only read nodes)
+    const NodeCollection* _coll;
+
+    // level of the algorithm's messages (-1: the caller's)
+    int _log_level;
 
   };
 }
@@ -14,6 +14,8 @@ namespace geotree{
   void AlgoGenericConflictComplex::ResolveConflict(const NodeID_t& id, const NodeID_t& parent, const NodeID_t& sibling)
   {
 
+    Logger::Scope log(msg::kAlgo,_log_level);
+
     // since we are starting fresh, clear correlations currently stored
     ClearCorrelations();
 
@@ -21,43 +23,44 @@ namespace geotree{
     std::pair<NodeID_t,NodeID_t> nodePair;
 
     // get all siblings
-    auto siblings = _coll->GetNode(id).getSiblings();
+    IDList_t siblings;
+    _coll->GetNode(id).getSiblings(siblings);
 
     if (_loose){
       // Assign parent as parent to all others (with score of parent)
       auto parentScore = _coll->GetNode(id).getScore(parent);
       // vertex is average of vtx for parent and vertices for siblings
-      auto parentVtx = _coll->GetNode(id).getVtx(parent);
+      auto parentVtx = _coll->Vertex(_coll->GetNode(id).getVtxID(parent));
       std::vector<::geoalgo::Vector_t> vtxList;
       vtxList.push_back(parentVtx);
       for (auto& sID : siblings)
-	vtxList.push_back(_coll->GetNode(id).getVtx(sID));
+	vtxList.push_back(_coll->Vertex(_coll->GetNode(id).getVtxID(sID)));
       // find "average" vertex location
-      if (_verbose) { 
-	std::cout << "\tFind Bounding Sphere from points: " << std::endl;
+      if (GEOTREE_LOG_ENABLED(msg::kAlgo,msg::kDEBUG)){
+	GEOTREE_DEBUG(msg::kAlgo, "\tFind Bounding Sphere from points: ");
 	for (size_t v=0; v < vtxList.size(); v++){
 	  if (v==0)
-	    std::cout << "\tParent ID : " << parent << "\tVtx: "<< parentVtx << std::endl;
+	    GEOTREE_DEBUG(msg::kAlgo, "\tParent ID : " << parent << "\tVtx: "<< parentVtx);
 	  else
-	    std::cout << "\tSibling ID: " << parent << "\tVtx: "<< vtxList[v] << std::endl;
+	    GEOTREE_DEBUG(msg::kAlgo, "\tSibling ID: " << parent << "\tVtx: "<< vtxList[v]);
 	}
       }
       ::geoalgo::Point_t newVtx = _geoAlgo.boundingSphere(vtxList).Center();
-      if (_verbose) { std::cout << "\taverage vtx from " << siblings.size() << " siblings is: " << newVtx << std::endl; }
+      GEOTREE_DEBUG(msg::kAlgo, "\taverage vtx from " << siblings.size() << " siblings is: " << newVtx);
       // Edit all sibling & parent correlations to match the new vertex information
-      if (_verbose) { std::cout << "\tEditing Corr Vtx between this ID " << id << " and Parent " << parent << std::endl; }
+      GEOTREE_DEBUG(msg::kAlgo, "\tEditing Corr Vtx between this ID " << id << " and Parent " << parent);
       nodePair = std::make_pair(id,parent);
       Correlation corr(_coll->GetNode(id).getScore(parent),newVtx,_coll->GetNode(id).getRelation(parent));
       _corr_v[nodePair] = corr;
       for (size_t s1 = 0; s1 < siblings.size(); s1++){
-	if (_verbose) { std::cout << "\tEditing Corr Vtx between this ID " << id << "and sibling " << siblings[s1] << std::endl; }
+	GEOTREE_DEBUG(msg::kAlgo, "\tEditing Corr Vtx between this ID " << id << "and sibling " << siblings[s1]);
 	nodePair = std::make_pair(id,siblings[s1]);
 	Correlation corr(_coll->GetNode(id).getScore(siblings[s1]),newVtx,_coll->GetNode(id).getRelation(siblings[s1]));
 	_corr_v[nodePair] = corr;
 	// Also, edit the correlations amongst the various siblings -> STUPID!!!
 	for (size_t s2 = s1+1; s2 < siblings.size(); s2++){
 	  if (s2 != id){
-	    if (_verbose) { std::cout << "\tEditing Corr Vtx between siblings " << siblings[s1] << " and " << siblings[s2] << std::endl; }
+	    GEOTREE_DEBUG(msg::kAlgo, "\tEditing Corr Vtx between siblings " << siblings[s1] << " and " << siblings[s2]);
 	    nodePair = std::make_pair(siblings[s1],siblings[s2]);
 	    Correlation corr(_coll->GetNode(siblings[s1]).getScore(siblings[s2]),newVtx,_coll->GetNode(siblings[s1]).getRelation(siblings[s2]));
 	    _corr_v[nodePair] = corr;
@@ -65,15 +68,15 @@ namespace geotree{
 	}
 	// Finally, if a parent exists edit vtx
 	// if it does not exist, add parent
-	if (_coll->GetNode(siblings[s1]).hasParent() == true){
+	if (_coll->GetNode(siblings[s1]).nParents() == 1){
 	  // ASSUME SAME PARENT!!!
-	  if (_verbose) { std::cout << "\tEditing Corr Vtx between Sibling " << siblings[s1] << " & Parent " << parent << std::endl; }
+	  GEOTREE_DEBUG(msg::kAlgo, "\tEditing Corr Vtx between Sibling " << siblings[s1] << " & Parent " << parent);
 	  nodePair = std::make_pair(siblings[s1],parent);
 	  Correlation corr(_coll->GetNode(siblings[s1]).getScore(parent),newVtx,_coll->GetNode(siblings[s1]).getRelation(parent));
 	  _corr_v[nodePair] = corr;
 	}
 	  else{
-	    if (_verbose) { std::cout << "\tAdding Corr Vtx between Sibling " << siblings[s1] << " & Parent " << parent << std::endl; }
+	    GEOTREE_DEBUG(msg::kAlgo, "\tAdding Corr Vtx between Sibling " << siblings[s1] << " & Parent " << parent);
 	    nodePair = std::make_pair(siblings[s1],parent);
 	    Correlation corr(parentScore,newVtx,::geotree::RelationType_t::kChild);
 	    _corr_v[nodePair] = corr;
@@ -86,10 +89,10 @@ namespace geotree{
       auto parentScore  = _coll->GetNode(id).getScore(parent);
       // get score for first sibling (assuming sibling sorting already happened
       auto siblingScore = _coll->GetNode(id).getScore(siblings[0]);
-      if (_verbose) { std::cout << "\tNot loose. Parent Score: " << parentScore << " and sibling score: " << siblingScore << std::endl; }
+      GEOTREE_DEBUG(msg::kAlgo, "\tNot loose. Parent Score: " << parentScore << " and sibling score: " << siblingScore);
       if (parentScore > siblingScore){
 	// remove sibling score
-	if (_verbose) { std::cout << "\tErase sibling correlation" << std::endl; }
+	GEOTREE_DEBUG(msg::kAlgo, "\tErase sibling correlation");
 	// for all siblings
 	for (auto& s : siblings){
 	  Correlation corr(-1, ::geoalgo::Point_t(), ::geotree::RelationType_t::kUnknown);
@@ -100,7 +103,7 @@ namespace geotree{
       // if sibling is better
       else{
 	// remove parent score
-	if (_verbose) { std::cout << "\tErase parent correlation" << std::endl; }
+	GEOTREE_DEBUG(msg::kAlgo, "\tErase parent correlation");
 	Correlation corr(-1, ::geoalgo::Point_t(), ::geotree::RelationType_t::kUnknown);
 	nodePair = std::make_pair(id,parent);
 	_corr_v[nodePair] = corr;
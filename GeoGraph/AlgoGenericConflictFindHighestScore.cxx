@@ -14,6 +14,8 @@ namespace geotree{
   void AlgoGenericConflictFindHighestScore::ResolveConflict(const NodeID_t& id, const NodeID_t& parent, const NodeID_t& sibling)
   {
 
+    Logger::Scope log(msg::kAlgo,_log_level);
+
     // since we are starting fresh, clear correlations currently stored
     ClearCorrelations();
     
@@ -26,14 +28,14 @@ namespace geotree{
 
     // if parent score is higher than sibling's
     if (parentScore > siblingScore){
-      if (_verbose) { std::cout << "\tParent's score is larger than sibling's. Remove corr. w/ sibling " << std::endl; } 
+      GEOTREE_DEBUG(msg::kAlgo, "\tParent's score is larger than sibling's. Remove corr. w/ sibling "); 
       Correlation corr(-1, ::geoalgo::Point_t(), ::geotree::RelationType_t::kUnknown);
       nodePair = std::make_pair(id,sibling);
       _corr_v[nodePair] = corr;
     }
     else{
       // if sibling's score is larger
-      if (_verbose) { std::cout << "\tSibling's score is larger than parent's. Remove corr. w/ parent" << std::endl; } 
+      GEOTREE_DEBUG(msg::kAlgo, "\tSibling's score is larger than parent's. Remove corr. w/ parent"); 
       Correlation corr(-1, ::geoalgo::Point_t(), ::geotree::RelationType_t::kUnknown);
       nodePair = std::make_pair(id,parent);
       _corr_v[nodePair] = corr;
@@ -14,23 +14,29 @@ namespace geotree{
   void AlgoGenericConflictRemoveSibling::ResolveConflict(const NodeID_t& id, const NodeID_t& parent, const NodeID_t& sibling)
   {
 
+    Logger::Scope log(msg::kAlgo,_log_level);
+
     // since we are starting fresh, clear correlations currently stored
     ClearCorrelations();
     
     // prepare a std::pair holder
     std::pair<NodeID_t,NodeID_t> nodePair;
 
+    NodeID_t sibParent;
+    Status_t status = _coll->GetNode(sibling).tryGetParent(sibParent);
+
     // if sibling does not have the same parent -> remove sibling relation
-    if (_coll->GetNode(sibling).hasParent() == false){
-      if (_verbose) { std::cout << "\tsibling does not have the same parent. Remove sibling realtion " << std::endl; } 
+    if (status == kNoParent){
+      GEOTREE_DEBUG(msg::kAlgo, "\tsibling does not have the same parent. Remove sibling realtion "); 
       Correlation corr(-1, ::geoalgo::Point_t(), ::geotree::RelationType_t::kUnknown);
       nodePair = std::make_pair(id,sibling);
       _corr_v[nodePair] = corr;
     }
     
     // if parent exists but is different -> remove sibling relation
-    else if (_coll->GetNode(sibling).getParent() != parent){
-      if (_verbose) { std::cout << "\tsibling parent different from this node's parent. Remove sibling realtion " << std::endl; } 
+    // (several parents: none of them can be assumed to be the same)
+    else if ( (status == kMultipleParents) or (sibParent != parent) ){
+      GEOTREE_DEBUG(msg::kAlgo, "\tsibling parent different from this node's parent. Remove sibling realtion "); 
       Correlation corr(-1, ::geoalgo::Point_t(), ::geotree::RelationType_t::kUnknown);
       nodePair = std::make_pair(id,sibling);
       _corr_v[nodePair] = corr;
@@ -25,9 +25,9 @@ namespace geotree{
     AlgoMultipleParentsBase() { _name="MultipleParents"; }
 
     /// Constructor which syncs node collection for the algorithm
-    AlgoMultipleParentsBase(NodeCollection* coll) { _name="MultipleParents"; _coll = coll; _verbose = false; }
+    AlgoMultipleParentsBase(NodeCollection* coll) { _name="MultipleParents"; _coll = coll; }
 
-    virtual void FindBestParent(const NodeID_t& id, const std::vector<NodeID_t>& parents) {}
+    virtual void FindBestParent(const NodeID_t& id, const IDList_t& parents) {}
 
   };
 }
@@ -11,9 +11,11 @@ namespace geotree{
     _name = "MultipleParentsHighScore";
   }
 
-  void AlgoMultipleParentsHighScore::FindBestParent(const NodeID_t& id, const std::vector<NodeID_t>& parents)
+  void AlgoMultipleParentsHighScore::FindBestParent(const NodeID_t& id, const IDList_t& parents)
   {
 
+    Logger::Scope log(msg::kAlgo,_log_level);
+
     // since we are starting fresh, clear correlations currently stored
     ClearCorrelations();
 
@@ -23,14 +25,14 @@ namespace geotree{
     for (size_t n=0; n < parents.size(); n++){
       // geto score
       double thisScore = _coll->GetNode(id).getScore(parents[n]);
-      if (_verbose) { std::cout << "\tID: " << id << "\tparent: " << parents[n] << "\tScore: " << thisScore << std::endl; }
+      GEOTREE_DEBUG(msg::kAlgo, "\tID: " << id << "\tparent: " << parents[n] << "\tScore: " << thisScore);
       if (thisScore > highScore){
 	highScore = thisScore;
 	bestParent = parents[n];
       }// if temporary best parent
     }// for all parents
 
-    if (_verbose) { std::cout << "Best Parent: " << bestParent << std::endl; }
+    GEOTREE_DEBUG(msg::kAlgo, "Best Parent: " << bestParent);
     // we have the best parent
     // now edit correlations appropriately
     // i.e. remove all correlations with nodes
@@ -36,7 +36,7 @@ namespace geotree{
     /// Constructor which syncs node collection for the algorithm
     AlgoMultipleParentsHighScore(NodeCollection* coll);
 
-    void FindBestParent(const NodeID_t& id, const std::vector<NodeID_t>& parents);
+    void FindBestParent(const NodeID_t& id, const IDList_t& parents);
 
   };
 }
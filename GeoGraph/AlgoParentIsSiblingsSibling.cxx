@@ -14,6 +14,8 @@ namespace geotree{
   void AlgoParentIsSiblingsSibling::ResolveConflict(const NodeID_t& id, const NodeID_t& parent, const NodeID_t& sibling)
   {
 
+    Logger::Scope log(msg::kAlgo,_log_level);
+
     // since we are starting fresh, clear correlations currently stored
     ClearCorrelations();
 
@@ -30,13 +32,13 @@ namespace geotree{
     double A = _coll->GetNode(id).getScore(parent);
     double B = _coll->GetNode(parent).getScore(sibling);
     if (A > B){
-      if (_verbose) { std::cout << "keep sibling. Remove relation between parent and sibling" << std::endl; }
+      GEOTREE_DEBUG(msg::kAlgo, "keep sibling. Remove relation between parent and sibling");
       Correlation corr(-1, ::geoalgo::Point_t(), ::geotree::RelationType_t::kUnknown);
       nodePair = std::make_pair(parent,sibling);
       _corr_v[nodePair] = corr;
     }
     else{
-      if (_verbose) { std::cout << "keep parent. Remove relation with sibling" << std::endl; }
+      GEOTREE_DEBUG(msg::kAlgo, "keep parent. Remove relation with sibling");
       Correlation corr(-1, ::geoalgo::Point_t(), ::geotree::RelationType_t::kUnknown);
       nodePair = std::make_pair(id,sibling);
       _corr_v[nodePair] = corr;
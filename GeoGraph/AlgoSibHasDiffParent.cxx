@@ -14,6 +14,8 @@ namespace geotree{
   void AlgoSibHasDiffParent::ResolveConflict(const NodeID_t& id, const NodeID_t& parent, const NodeID_t& sibling)
   {
 
+    Logger::Scope log(msg::kAlgo,_log_level);
+
     // make pair holder
     std::pair<NodeID_t,NodeID_t> nodePair;
 
@@ -21,11 +23,12 @@ namespace geotree{
     ClearCorrelations();
 
     // get siblings of this node
-    auto const siblings = _coll->GetNode(id).getSiblings();
+    IDList_t siblings;
+    _coll->GetNode(id).getSiblings(siblings);
 
     // if multiple siblings -> remove sibling relation
     if (siblings.size() > 1){
-      if (_verbose) { std::cout << "\tMany siblings: removing sibling relation because easiest now!" << std::endl; }
+      GEOTREE_DEBUG(msg::kAlgo, "\tMany siblings: removing sibling relation because easiest now!");
       nodePair = std::make_pair(id,parent);
       Correlation corr(-1, ::geoalgo::Point_t(), ::geotree::RelationType_t::kUnknown);
       _corr_v[nodePair] = corr;
@@ -56,29 +59,27 @@ namespace geotree{
     double B = sibParentScore + sibScore;
     double C = parentScore + sibParentScore;
     
-    if (_verbose){
-      std::cout << "\t\tA) : (ID,Sibling) + (ID,parent)         = " << A << std::endl;
-      std::cout << "\t\tB) : (ID,Sibling) + (sibling,sibParent) = " << B << std::endl;
-      std::cout << "\t\tC) : (ID,parent)  + (sibling,sibParent) = " << C << std::endl;
-    }
+    GEOTREE_DEBUG(msg::kAlgo, "\t\tA) : (ID,Sibling) + (ID,parent)         = " << A);
+    GEOTREE_DEBUG(msg::kAlgo, "\t\tB) : (ID,Sibling) + (sibling,sibParent) = " << B);
+    GEOTREE_DEBUG(msg::kAlgo, "\t\tC) : (ID,parent)  + (sibling,sibParent) = " << C);
     
     if ( (A > B) and (A > C) ){
       // remove sibling's parentage correlation
-      if (_verbose) { std::cout << "\tChoosing A" << std::endl; }
+      GEOTREE_DEBUG(msg::kAlgo, "\tChoosing A");
       nodePair = std::make_pair(sibling,parent);
       Correlation corr(-1, ::geoalgo::Point_t(), ::geotree::RelationType_t::kUnknown);
       _corr_v[nodePair] = corr;
     }
     else if (B > C){
       // remove this node's parent correlation
-      if (_verbose) { std::cout << "\tChoosing B" << std::endl; }
+      GEOTREE_DEBUG(msg::kAlgo, "\tChoosing B");
       nodePair = std::make_pair(id,parent);
       Correlation corr(-1, ::geoalgo::Point_t(), ::geotree::RelationType_t::kUnknown);
       _corr_v[nodePair] = corr;
     }
     else{
       // remove sibling correlation
-      if (_verbose) { std::cout << "\tChoosing C" << std::endl; }
+      GEOTREE_DEBUG(msg::kAlgo, "\tChoosing C");
       nodePair = std::make_pair(id,sibling);
       Correlation corr(-1, ::geoalgo::Point_t(), ::geotree::RelationType_t::kUnknown);
       _corr_v[nodePair] = corr;
@@ -0,0 +1,323 @@
+#ifndef BEAMSEARCH_CXX
+#define BEAMSEARCH_CXX
+
+#include "BeamSearch.h"
+#include <algorithm>
+#include <functional>
+
+namespace geotree{
+
+  BeamSearch::BeamSearch(size_t width, size_t results)
+    : _loose(false)
+  {
+    SetWidth(width);
+    SetResults(results);
+  }
+
+
+  std::vector<BeamHypothesis> BeamSearch::Resolve(Manager& mgr){
+
+    _loose = mgr.isLoose();
+
+    NodeCollection const event = mgr.Snapshot();
+
+    // complete resolutions, greedy one first
+    std::vector<BeamHypothesis> finals;
+
+    try{
+      mgr.ResolveConflicts();
+      BeamHypothesis greedy;
+      greedy.forest = mgr.Snapshot();
+      greedy.score  = TotalScore(greedy.forest);
+      greedy.greedy = true;
+      finals.push_back(greedy);
+    }
+    catch (std::exception& ex){
+      GEOTREE_DEBUG(msg::kManager, "BeamSearch: greedy resolution failed: " << ex.what());
+    }
+
+    // beam over the partial hypotheses
+    std::vector<State> beam(1);
+    beam[0].coll  = event;
+    beam[0].score = TotalScore(event);
+    beam[0].phase = kParents;
+    beam[0].conflicts = std::make_shared< const std::vector<Conflict> >(Conflicts(event,kParents));
+    beam[0].next  = 0;
+
+    IDList_t alts;
+
+    while (true){
+
+      bool pending = false;
+      std::vector<State> expanded;
+
+      for (auto& state : beam){
+
+	if (state.phase == kDone){
+	  expanded.push_back(state);
+	  continue;
+	}
+	pending = true;
+
+	// phase complete: deterministic passes, then next phase
+	if (state.next == state.conflicts->size()){
+	  try{
+	    Advance(mgr,state);
+	    expanded.push_back(state);
+	  }
+	  catch (std::exception& ex){
+	    GEOTREE_DEBUG(msg::kManager, "BeamSearch: hypothesis dropped: " << ex.what());
+	  }
+	  continue;
+	}
+
+	NodeID_t const node = (*state.conflicts)[state.next].node;
+	state.next += 1;
+
+	// earlier decisions may have solved this conflict already
+	Alternatives(state.coll,node,state.phase,alts);
+	if (alts.empty()){
+	  expanded.push_back(state);
+	  continue;
+	}
+
+	// one child per alternative: keep it, erase the others
+	for (auto const& keep : alts){
+	  State child = state;
+	  for (auto const& other : alts){
+	    if (other == keep) continue;
+	    child.score -= child.coll.FindNode(node)->getScore(other);
+	    child.coll.EditNode(node)->eraseCorrelation(other);
+	    child.coll.EditNode(other)->eraseCorrelation(node);
+	  }
+	  child.decisions.push_back(std::make_pair(node,keep));
+	  expanded.push_back(child);
+	}
+      }// for all hypotheses in the beam
+
+      // keep the best K (stable: equal scores keep their order)
+      std::stable_sort(expanded.begin(),expanded.end(),
+		       [](const State& a, const State& b) { return a.score > b.score; });
+      if (expanded.size() > _width)
+	expanded.resize(_width);
+      beam.swap(expanded);
+
+      if (pending == false)
+	break;
+    }// while hypotheses are incomplete
+
+    for (auto& state : beam){
+      BeamHypothesis h;
+      h.forest    = state.coll;
+      h.score     = TotalScore(state.coll);
+      h.greedy    = false;
+      h.decisions = state.decisions;
+      finals.push_back(h);
+    }
+
+    // best first, drop duplicate graphs (the greedy one wins a tie)
+    std::stable_sort(finals.begin(),finals.end(),
+		     [](const BeamHypothesis& a, const BeamHypothesis& b) { return a.score > b.score; });
+
+    // the trees of the hypotheses are made by a helper with the
+    // settings of mgr, which does not publish them
+    Manager trees;
+    trees.setPublishing(false);
+    trees.setLoose(mgr.isLoose());
+    trees.setSiblingMatching(mgr.isSiblingMatching());
+    trees.setForestThreads(mgr.getForestThreads());
+    trees.setLogLevel(mgr.getLogLevel());
+
+    std::vector<BeamHypothesis> results;
+    std::vector<size_t> signatures;
+    // resolved graphs of the results (before their trees are made)
+    std::vector<NodeCollection> graphs;
+    for (auto& h : finals){
+      if (results.size() == _results)
+	break;
+      // equal signatures are only a hint: compare the graphs
+      size_t const sig = Signature(h.forest);
+      bool duplicate = false;
+      for (size_t r=0; (r < signatures.size()) and (duplicate == false); r++)
+	duplicate = (signatures[r] == sig) and SameGraph(graphs[r],h.forest);
+      if (duplicate)
+	continue;
+      NodeCollection const graph = h.forest;
+      // make the tree of this hypothesis (in the helper: only the
+      // best forest is made and published by mgr, see below)
+      try{
+	trees.LoadSnapshot(h.forest);
+	trees.MakeTree();
+	h.forest = trees.Snapshot();
+      }
+      catch (std::exception& ex){
+	GEOTREE_DEBUG(msg::kManager, "BeamSearch: no tree for hypothesis: " << ex.what());
+	continue;
+      }
+      signatures.push_back(sig);
+      graphs.push_back(graph);
+      results.push_back(h);
+    }
+
+    if (results.empty()){
+      mgr.LoadSnapshot(event);
+      throw ::geoalgo::GeoAlgoException("BeamSearch: no hypothesis could be turned into a tree");
+    }
+
+    // the best tree is made once more by mgr, so that LastForest and
+    // the published forest are the best one (one Event per Resolve)
+    mgr.LoadSnapshot(graphs[0]);
+    mgr.MakeTree();
+    results[0].forest = mgr.Snapshot();
+
+    return results;
+  }
+
+
+  void BeamSearch::Alternatives(const NodeCollection& coll, NodeID_t node, Phase_t phase,
+				IDList_t& alts) const {
+
+    alts.clear();
+
+    const Node* n = coll.FindNode(node);
+    if (n == nullptr)
+      return;
+
+    if (phase == kParents){
+      if (n->nParents() > 1)
+	n->getParents(alts);
+      return;
+    }
+
+    // siblings: a conflict only if they are not all at the same vertex
+    if (n->nSiblings() < 2)
+      return;
+    n->getSiblings(alts);
+    auto const vtx = n->findCorrelation(alts[0])->VtxID();
+    for (auto const& s : alts){
+      if (coll.Vertices().Same(n->findCorrelation(s)->VtxID(),vtx) == false)
+	return;
+    }
+    alts.clear();
+
+    return;
+  }
+
+
+  std::vector<BeamSearch::Conflict> BeamSearch::Conflicts(const NodeCollection& coll, Phase_t phase) const {
+
+    std::vector<Conflict> conflicts;
+    IDList_t alts;
+
+    for (auto const& ID : coll.GetNodeIDs()){
+      Alternatives(coll,ID,phase,alts);
+      if (alts.empty())
+	continue;
+      // margin between the two highest scores
+      const Node* n = coll.FindNode(ID);
+      double best = n->getScore(alts[0]);
+      double second = -1.e30;
+      for (size_t i=1; i < alts.size(); i++){
+	double const s = n->getScore(alts[i]);
+	if (s > best) { second = best; best = s; }
+	else if (s > second) { second = s; }
+      }
+      Conflict c = { ID, best-second };
+      conflicts.push_back(c);
+    }
+
+    // most confident first (node-ID order among equals)
+    std::stable_sort(conflicts.begin(),conflicts.end(),
+		     [](const Conflict& a, const Conflict& b) { return a.margin > b.margin; });
+
+    return conflicts;
+  }
+
+
+  void BeamSearch::Advance(Manager& mgr, State& state) const {
+
+    mgr.LoadSnapshot(state.coll);
+
+    if (state.phase == kParents){
+      mgr.ParentIsSiblingsSibling();
+      mgr.GenericConflict();
+      if (_loose){
+	// merging siblings takes no decision
+	mgr.SortSiblings();
+	state.phase = kDone;
+      }
+      else{
+	state.phase = kSiblings;
+      }
+    }
+    else{
+      state.phase = kDone;
+    }
+
+    state.coll  = mgr.Snapshot();
+    state.score = TotalScore(state.coll);
+    state.next  = 0;
+    state.conflicts = std::make_shared< const std::vector<Conflict> >();
+    if (state.phase == kSiblings)
+      state.conflicts = std::make_shared< const std::vector<Conflict> >(Conflicts(state.coll,kSiblings));
+
+    return;
+  }
+
+
+  double BeamSearch::TotalScore(const NodeCollection& coll){
+
+    double score = 0;
+    for (auto const& ID : coll.GetNodeIDs()){
+      for (auto const& c : coll.FindNode(ID)->correlations()){
+	if (c.ID() > ID)
+	  score += c.Score();
+      }
+    }
+
+    return score;
+  }
+
+
+  size_t BeamSearch::Signature(const NodeCollection& coll){
+
+    std::hash<size_t> hasher;
+    size_t sig = 0;
+    for (auto const& ID : coll.GetNodeIDs()){
+      for (auto const& c : coll.FindNode(ID)->correlations()){
+	if (c.ID() < ID)
+	  continue;
+	size_t const h = hasher(ID*1000003 + c.ID()*31 + (size_t)c.Relation());
+	sig ^= h + 0x9e3779b97f4a7c15ULL + (sig << 6) + (sig >> 2);
+      }
+    }
+
+    return sig;
+  }
+
+
+  bool BeamSearch::SameGraph(const NodeCollection& a, const NodeCollection& b){
+
+    if (a.NodeCount() != b.NodeCount())
+      return false;
+
+    for (auto const& ID : a.GetNodeIDs()){
+      const Node* na = a.FindNode(ID);
+      const Node* nb = b.FindNode(ID);
+      if ( (nb == nullptr) or (na->nCorrelations() != nb->nCorrelations()) )
+	return false;
+      // entries are kept in the same order (by relation, then ID)
+      for (size_t i=0; i < na->nCorrelations(); i++){
+	auto const& ca = na->correlationAt(i);
+	auto const& cb = nb->correlationAt(i);
+	if ( (ca.ID() != cb.ID()) or (ca.Relation() != cb.Relation()) )
+	  return false;
+      }
+    }
+
+    return true;
+  }
+
+}
+
+#endif
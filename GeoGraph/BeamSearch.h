@@ -0,0 +1,142 @@
+/**
+ * \file BeamSearch.h
+ *
+ * \ingroup GeoTree
+ *
+ * \brief Class def header for a class geotree::BeamSearch
+ *
+ * @author david caratelli
+ */
+
+/** \addtogroup GeoTree
+    Multi-hypothesis alternative to Manager::ResolveConflicts.
+    The greedy resolution takes one decision per conflict in
+    node-ID order. The beam search instead keeps the K best
+    partial hypotheses, scored by the total score of the
+    correlations they keep, and extends each of them with every
+    alternative of its next conflict:
+    - multiple parents: which parent to keep
+    - multiple siblings at different vertices (strict mode only):
+      which sibling to keep
+    Conflicts are taken in order of confidence (largest score
+    margin between the best and second-best alternative first),
+    so that ambiguous decisions are made last. Between the parent
+    and sibling phases the deterministic passes
+    (ParentIsSiblingsSibling, GenericConflict, and SortSiblings in
+    loose mode) run on each hypothesis.
+    Hypotheses are NodeCollection snapshots: they share all nodes
+    that their decisions did not touch, so the memory per
+    hypothesis is one pointer per node plus the edited nodes.
+    The greedy resolution is always evaluated too, so the best
+    result is never worse than ResolveConflicts.
+    Usage:
+    BeamSearch beam(8);
+    auto results = beam.Resolve(mgr); // mgr now holds the best forest
+    for (auto& h : results) { std::cout << h.score << std::endl; h.forest.Diagram(); }
+    @{*/
+#ifndef BEAMSEARCH_H
+#define BEAMSEARCH_H
+
+#include "Manager.h"
+
+namespace geotree{
+
+  /**
+     \class geotree::BeamHypothesis
+     One complete interpretation of the event
+  */
+  struct BeamHypothesis{
+    /// total score of the correlations kept by the resolution
+    double score;
+    /// true for the greedy (ResolveConflicts) resolution
+    bool greedy;
+    /// decisions taken: (node, kept parent or sibling)
+    std::vector< std::pair<NodeID_t, NodeID_t> > decisions;
+    /// resolved graph with its tree (use Diagram() to print it)
+    NodeCollection forest;
+  };
+
+  /**
+     \class geotree::BeamSearch
+     Beam search over conflict resolutions
+  */
+  class BeamSearch{
+
+  public:
+
+    /// Constructor: beam width and number of results returned
+    BeamSearch(size_t width = 8, size_t results = 3);
+
+    virtual ~BeamSearch(){}
+
+    /// Beam width (number of partial hypotheses kept)
+    void SetWidth(size_t width) { _width = (width > 0) ? width : 1; }
+
+    /// Number of hypotheses returned (best first)
+    void SetResults(size_t results) { _results = (results > 0) ? results : 1; }
+
+    /// Resolve the event held by the manager and make the trees.
+    /// The manager is left holding the best forest: it is the only
+    /// tree MakeTree'd (and published) by the manager, the trees of
+    /// the runners-up are made by a helper. Returns the
+    /// best and the runners-up (distinct graphs), highest score first.
+    /// Throws if no hypothesis can be turned into a tree.
+    std::vector<BeamHypothesis> Resolve(Manager& mgr);
+
+    /// Total score of the correlations in a collection (each pair counted once)
+    static double TotalScore(const NodeCollection& coll);
+
+  private:
+
+    /// which phase a partial hypothesis is in
+    enum Phase_t {
+      kParents,
+      kSiblings,
+      kDone
+    };
+
+    /// a node with more than one alternative
+    struct Conflict{
+      NodeID_t node;
+      /// best score minus second-best score
+      double margin;
+    };
+
+    /// partial hypothesis
+    struct State{
+      NodeCollection coll;
+      double score;
+      Phase_t phase;
+      /// conflicts of the phase (shared by all hypotheses derived from the same state)
+      std::shared_ptr< const std::vector<Conflict> > conflicts;
+      size_t next;
+      std::vector< std::pair<NodeID_t, NodeID_t> > decisions;
+    };
+
+    /// alternatives for a node in the current phase (empty if no conflict)
+    void Alternatives(const NodeCollection& coll, NodeID_t node, Phase_t phase,
+		      IDList_t& alts) const;
+
+    /// conflicts of a phase, most confident first
+    std::vector<Conflict> Conflicts(const NodeCollection& coll, Phase_t phase) const;
+
+    /// run the deterministic passes that close a phase and set up the next one
+    void Advance(Manager& mgr, State& state) const;
+
+    /// identifies the correlations of a graph (to drop duplicate hypotheses)
+    static size_t Signature(const NodeCollection& coll);
+
+    /// same nodes and same correlations (node pairs and relations, as
+    /// hashed by Signature)? Decides when two signatures are equal
+    static bool SameGraph(const NodeCollection& a, const NodeCollection& b);
+
+    size_t _width;
+    size_t _results;
+    bool _loose;
+
+  };
+
+}
+
+#endif
+/** @} */ // end of doxygen group
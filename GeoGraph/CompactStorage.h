@@ -0,0 +1,83 @@
+/**
+ * \file CompactStorage.h
+ *
+ * \ingroup GeoTree
+ *
+ * \brief Storage types of correlations and vertices
+ *
+ * @author david caratelli
+ */
+
+/** \addtogroup GeoTree
+    Types used to store correlations (in the nodes) and vertices
+    (in the VertexTable). By default scores and coordinates are
+    stored as given, in double precision.
+    Compiled with -DGEOTREE_COMPACT (see GNUmakefile; every
+    translation unit using the package must agree) they are
+    stored in reduced precision:
+    - scores: float. Relative error at most 2^-24 (6.0e-8):
+      |s' - s| <= 6.0e-8 |s|
+    - vertices: float coordinates relative to the detector-frame
+      origin GEOTREE_ORIGIN_X/Y/Z (cm, default 0,0,0), so the
+      error grows with the distance from it: |x' - x| <= 6.0e-8
+      |x - x0| (0.3 um within 5 m of the origin; double rounding
+      of x0 + offset adds 1.1e-16 |x|). Vertices have at most 3
+      coordinates
+    - the node ID in a correlation entry: 32 bits (IDs must be
+      below 2^32) and the relation type: 8 bits
+    A correlation entry (one per endpoint) goes from 24 to 16
+    bytes and a vertex from a heap-allocated Point_t (~64 bytes
+    with its allocation) to 13 bytes plus its class links.
+    Values are rounded when stored: two scores (or vertices)
+    that differ by less than the bounds above become equal, so
+    ties, and which vertices are Same(), may come out differently
+    than in double precision. Everything read back (Score(),
+    points, forests) is double.
+    @{*/
+#ifndef COMPACTSTORAGE_H
+#define COMPACTSTORAGE_H
+
+#include <cstddef>
+
+#ifndef GEOTREE_ORIGIN_X
+#define GEOTREE_ORIGIN_X 0.
+#endif
+#ifndef GEOTREE_ORIGIN_Y
+#define GEOTREE_ORIGIN_Y 0.
+#endif
+#ifndef GEOTREE_ORIGIN_Z
+#define GEOTREE_ORIGIN_Z 0.
+#endif
+
+namespace geotree{
+
+#ifdef GEOTREE_COMPACT
+  /// score as stored in a correlation entry
+  typedef float Score_t;
+  /// vertex coordinate as stored (relative to the origin)
+  typedef float Coord_t;
+  /// node ID as stored in a correlation entry
+  typedef unsigned int StoredNodeID_t;
+  /// relation type as stored in a correlation entry
+  typedef unsigned char StoredRelation_t;
+#else
+  typedef double Score_t;
+  typedef double Coord_t;
+  typedef size_t StoredNodeID_t;
+  typedef int StoredRelation_t;
+#endif
+
+  /// compact storage compiled in?
+#ifdef GEOTREE_COMPACT
+  static const bool kCompactStorage = true;
+#else
+  static const bool kCompactStorage = false;
+#endif
+
+  /// detector-frame origin of the stored coordinates
+  static const double kVertexOrigin[3] = { GEOTREE_ORIGIN_X, GEOTREE_ORIGIN_Y, GEOTREE_ORIGIN_Z };
+
+}
+
+#endif
+/** @} */ // end of doxygen group
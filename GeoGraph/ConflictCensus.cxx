@@ -0,0 +1,144 @@
+#ifndef CONFLICTCENSUS_CXX
+#define CONFLICTCENSUS_CXX
+
+#include "ConflictCensus.h"
+#include "NodeCollection.h"
+
+namespace geotree{
+
+  void ConflictCensus::Take(const NodeCollection& coll){
+
+    Clear();
+
+    _nodes = coll.NodeCount();
+    _flags.assign(_nodes,0);
+
+    for (size_t i=0; i < _nodes; i++){
+
+      const Node& node = coll.NodeAt(i);
+      size_t const parents  = node.parents().size();
+      size_t const siblings = node.siblings().size();
+
+      unsigned char flags = 0;
+      if (parents > 1)
+	flags |= kMultipleParents;
+      if ( (parents > 0) and (siblings > 0) )
+	flags |= kParentSibling;
+      if (siblings > 1)
+	flags |= kMultipleSiblings;
+      _flags[i] = flags;
+
+      for (size_t s=0; s < 3; s++)
+	if (flags & (1 << s)) _count[s] += 1;
+
+      // for monitoring: is a sibling correlated to a parent
+      // other than as its child?
+      if ( (flags & kParentSibling) == 0 )
+	continue;
+      bool disagree = false;
+      for (auto const& sib : node.siblings()){
+	const Node* other = coll.FindNode(sib.ID());
+	for (auto const& par : node.parents()){
+	  auto const corr = other->findCorrelation(par.ID());
+	  if ( (corr != nullptr) and (corr->Relation() != ::geotree::RelationType_t::kParent) )
+	    disagree = true;
+	}
+	if (disagree)
+	  break;
+      }
+      if (disagree)
+	_parentIsSiblingsSibling += 1;
+    }
+
+    for (size_t s=0; s < 3; s++)
+      _flagged[s] = _count[s];
+    _active = true;
+
+    return;
+  }
+
+
+  void ConflictCensus::Done(){
+
+    _active = false;
+    _flags.clear();
+    for (size_t s=0; s < 3; s++)
+      _flagged[s] = 0;
+
+    return;
+  }
+
+
+  void ConflictCensus::Clear(){
+
+    _active = false;
+    _nodes  = 0;
+    _flags.clear();
+    for (size_t s=0; s < 3; s++){
+      _count[s]   = 0;
+      _flagged[s] = 0;
+    }
+    _parentIsSiblingsSibling = 0;
+    _touched = 0;
+
+    return;
+  }
+
+
+  void ConflictCensus::Touch(size_t pos){
+
+    if ( (_active == false) or (pos >= _flags.size()) )
+      return;
+
+    if (_flags[pos] != kAllFlags)
+      _touched += 1;
+    for (size_t s=0; s < 3; s++)
+      if ( (_flags[pos] & (1 << s)) == 0 ) _flagged[s] += 1;
+    _flags[pos] = kAllFlags;
+
+    return;
+  }
+
+
+  size_t ConflictCensus::Next(Flag_t flag, size_t pos) const {
+
+    size_t const n = _flags.size();
+    while ( (pos < n) and ((_flags[pos] & flag) == 0) )
+      pos++;
+
+    return pos;
+  }
+
+
+  size_t ConflictCensus::Flagged(Flag_t flag) const {
+
+    return _flagged[Slot(flag)];
+  }
+
+
+  bool ConflictCensus::Trivial() const {
+
+    return ( (_flagged[0] == 0) and (_flagged[1] == 0) and (_flagged[2] == 0) );
+  }
+
+
+  size_t ConflictCensus::Count(Flag_t flag) const {
+
+    return _count[Slot(flag)];
+  }
+
+
+  size_t ConflictCensus::Slot(Flag_t flag){
+
+    switch (flag){
+    case kMultipleParents:  return 0;
+    case kParentSibling:    return 1;
+    case kMultipleSiblings: return 2;
+    default:
+      throw ::geoalgo::GeoAlgoException("ConflictCensus: not a single flag");
+    }
+  }
+
+}
+
+#endif
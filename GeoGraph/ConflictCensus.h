@@ -0,0 +1,117 @@
+/**
+ * \file ConflictCensus.h
+ *
+ * \ingroup GeoTree
+ *
+ * \brief Class def header for a class geotree::ConflictCensus
+ *
+ * @author david caratelli
+ */
+
+/** \addtogroup GeoTree
+    Conflicts of an event, found in one pass over the nodes at the
+    start of Manager::ResolveConflicts. Each node (by position in
+    the NodeCollection) gets one flag per stage it is a candidate
+    for:
+    - kMultipleParents: 2 or more parents (FindBestParent)
+    - kParentSibling: a parent and a sibling
+      (ParentIsSiblingsSibling, GenericConflict)
+    - kMultipleSiblings: 2 or more siblings (SortSiblings)
+    The flags only depend on the node's own correlations. A stage
+    visits the flagged nodes in node order and is skipped when
+    none is flagged. A node whose correlations change while the
+    conflicts are resolved is flagged for every stage (Touch), so
+    that later stages, and later nodes of the current stage, see
+    it as the full passes would.
+    The counts taken by the census (Count, and the number of nodes
+    whose parent and sibling disagree, see ParentIsSiblingsSibling)
+    are kept for monitoring until the next census.
+    @{*/
+#ifndef CONFLICTCENSUS_H
+#define CONFLICTCENSUS_H
+
+#include <cstddef>
+#include <vector>
+
+namespace geotree{
+
+  class NodeCollection;
+
+  /**
+     \class geotree::ConflictCensus
+     Per-node conflict flags and counts of one event
+  */
+  class ConflictCensus{
+
+  public:
+
+    /// candidate flags (one per stage of ResolveConflicts)
+    enum Flag_t {
+      kMultipleParents  = 1,
+      kParentSibling    = 2,
+      kMultipleSiblings = 4,
+      kAllFlags         = 7
+    };
+
+    ConflictCensus() { Clear(); }
+
+    virtual ~ConflictCensus(){}
+
+    /// Classify every node of a collection (capacity is kept).
+    /// The census is active until Done
+    void Take(const NodeCollection& coll);
+
+    /// Stop tracking changes (flags are dropped, counts are kept)
+    void Done();
+
+    /// Drop flags and counts
+    void Clear();
+
+    /// is the census tracking changes?
+    bool Active() const { return _active; }
+
+    /// the correlations of the node at a position changed:
+    /// flag it for every stage
+    void Touch(size_t pos);
+
+    /// first flagged position >= pos (Size() if none)
+    size_t Next(Flag_t flag, size_t pos) const;
+
+    /// number of positions flagged now (census + touched)
+    size_t Flagged(Flag_t flag) const;
+
+    /// no node is flagged for any stage
+    bool Trivial() const;
+
+    /// number of nodes classified by the last census
+    size_t Size() const { return _nodes; }
+
+    /// number of nodes with a conflict at the last census
+    size_t Count(Flag_t flag) const;
+
+    /// nodes whose sibling is correlated to their parent
+    /// other than as its child, at the last census
+    size_t ParentIsSiblingsSibling() const { return _parentIsSiblingsSibling; }
+
+    /// nodes that Touch flagged for more stages than the census did
+    size_t Touched() const { return _touched; }
+
+  private:
+
+    static size_t Slot(Flag_t flag);
+
+    bool _active;
+    size_t _nodes;
+    std::vector<unsigned char> _flags;
+    /// per flag: census count, and flagged now
+    size_t _count[3];
+    size_t _flagged[3];
+    size_t _parentIsSiblingsSibling;
+    size_t _touched;
+
+  };
+
+}
+
+#endif
+/** @} */ // end of doxygen group
@@ -49,9 +49,12 @@ namespace geotree{
     
     /// Getters
     double Score() const { return _score; }
-    ::geoalgo::Point_t Vtx() const { return _vtx; }
+    const ::geoalgo::Point_t& Vtx() const { return _vtx; }
     ::geotree::RelationType_t Relation() const { return _type; }
 
+    /// Heap memory held by this correlation (vertex coordinates)
+    size_t HeapBytes() const { return _vtx.capacity()*sizeof(double); }
+
     /// Default destructor
     virtual ~Correlation(){}
 
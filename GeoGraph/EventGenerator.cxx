@@ -0,0 +1,146 @@
+#ifndef EVENTGENERATOR_CXX
+#define EVENTGENERATOR_CXX
+
+#include "EventGenerator.h"
+
+namespace geotree{
+
+  EventGenerator::EventGenerator()
+    : _n_nodes(100)
+    , _density(0.)
+    , _f_primary(0.2)
+    , _f_mult_parent(0.1)
+    , _f_parent_sibling(0.05)
+    , _f_mult_sibling(0.1)
+    , _rand(0)
+  {}
+
+  double EventGenerator::Uniform(double min, double max)
+  {
+    return std::uniform_real_distribution<double>(min,max)(_rand);
+  }
+
+  // detector-like box (cm)
+  ::geoalgo::Point_t EventGenerator::RandomPoint()
+  {
+    return ::geoalgo::Point_t(Uniform(0.,256.),Uniform(-116.,116.),Uniform(0.,1036.));
+  }
+
+  ::geoalgo::Point_t EventGenerator::Smear(const ::geoalgo::Point_t& pt, double dist)
+  {
+    return ::geoalgo::Point_t(pt[0]+Uniform(-dist,dist),
+			      pt[1]+Uniform(-dist,dist),
+			      pt[2]+Uniform(-dist,dist));
+  }
+
+  bool EventGenerator::Add(size_t i1, size_t i2, double score,
+			   const ::geoalgo::Point_t& vtx,
+			   const ::geotree::RelationType_t type)
+  {
+
+    if (i1 == i2)
+      return false;
+
+    auto key = (i1 < i2) ? std::make_pair(i1,i2) : std::make_pair(i2,i1);
+    if (_pairs.find(key) != _pairs.end())
+      return false;
+    _pairs.insert(key);
+
+    CorrelationRecord rec;
+    rec.id1   = _IDs[i1];
+    rec.id2   = _IDs[i2];
+    rec.score = score;
+    rec.vtx   = vtx;
+    rec.type  = type;
+    _corr_v.push_back(rec);
+
+    return true;
+  }
+
+  void EventGenerator::Generate()
+  {
+
+    _IDs.clear();
+    _corr_v.clear();
+    _pairs.clear();
+
+    // same ID convention as Manager::setObjects
+    for (size_t i=0; i < _n_nodes; i++)
+      _IDs.push_back(i*2);
+
+    if (_n_nodes == 0)
+      return;
+
+    // decay point of each node: where its children start
+    std::vector<::geoalgo::Point_t> end_v;
+    std::vector<size_t> primaries;
+    std::vector<bool> isPrimary(_n_nodes,false);
+
+    // 1) true forest: parents always have a lower index
+    for (size_t i=0; i < _n_nodes; i++){
+      end_v.push_back(RandomPoint());
+      if ( (i == 0) or (Uniform(0.,1.) < _f_primary) ){
+	isPrimary[i] = true;
+	primaries.push_back(i);
+	continue;
+      }
+      size_t p = std::uniform_int_distribution<size_t>(0,i-1)(_rand);
+      Add(p,i,Uniform(0.5,1.),end_v[p],::geotree::RelationType_t::kParent);
+    }
+
+    for (size_t i=1; i < _n_nodes; i++){
+
+      // 2) multiple parents: one or two extra candidates with a lower score
+      if ( (isPrimary[i] == false) and (Uniform(0.,1.) < _f_mult_parent) ){
+	size_t nextra = (Uniform(0.,1.) < 0.5) ? 1 : 2;
+	for (size_t n=0; n < nextra; n++){
+	  size_t p = std::uniform_int_distribution<size_t>(0,i-1)(_rand);
+	  Add(p,i,Uniform(0.1,0.5),Smear(end_v[p],5.),::geotree::RelationType_t::kParent);
+	}
+      }
+
+      // 3) weak random correlations (density)
+      double d = _density;
+      while (d > 0){
+	if ( (d >= 1) or (Uniform(0.,1.) < d) ){
+	  size_t p = std::uniform_int_distribution<size_t>(0,i-1)(_rand);
+	  Add(p,i,Uniform(0.01,0.2),Smear(end_v[p],20.),::geotree::RelationType_t::kParent);
+	}
+	d -= 1;
+      }
+
+      // 4) parent + sibling conflict
+      if ( (isPrimary[i] == false) and (Uniform(0.,1.) < _f_parent_sibling) ){
+	size_t s = std::uniform_int_distribution<size_t>(0,_n_nodes-1)(_rand);
+	Add(i,s,Uniform(0.2,0.9),Smear(end_v[i],5.),::geotree::RelationType_t::kSibling);
+      }
+    }
+
+    // 5) groups of 3 siblings (amongst primaries) with slightly different vertices
+    for (size_t n=0; n+2 < primaries.size(); n+=3){
+      if (Uniform(0.,1.) > _f_mult_sibling)
+	continue;
+      auto const vtx = RandomPoint();
+      for (size_t a=n; a < n+3; a++)
+	for (size_t b=a+1; b < n+3; b++)
+	  Add(primaries[a],primaries[b],Uniform(0.3,1.),Smear(vtx,2.),::geotree::RelationType_t::kSibling);
+    }
+
+    return;
+  }
+
+  void EventGenerator::Fill(Manager& mgr) const
+  {
+
+    mgr.Reset();
+    mgr.setObjects(_IDs.size());
+
+    for (auto const& c : _corr_v)
+      mgr.AddCorrelation(c.id1,c.id2,c.score,c.vtx,c.type);
+
+    return;
+  }
+
+}
+
+#endif
@@ -0,0 +1,128 @@
+/**
+ * \file EventGenerator.h
+ *
+ * \ingroup GeoTree
+ *
+ * \brief Class def header for a class geotree::EventGenerator
+ *
+ * @author david caratelli
+ */
+
+/** \addtogroup GeoTree
+    Synthetic event generator used for benchmarking.
+    An event is a list of nodes and of correlations
+    between them. The "true" structure is a forest in
+    which every parent has a lower index than its
+    children (so no parent cycles are generated).
+    On top of it the generator injects, with
+    configurable fractions:
+    - extra (lower score) parents -> multiple parents
+    - siblings for nodes which already have a parent
+    -> parent + sibling conflicts
+    - groups of 3 siblings with slightly different
+    vertices -> multiple siblings conflicts
+    - weak random parent correlations (density)
+    Node IDs follow the convention of Manager::setObjects
+    (ID = 2 * index).
+    @{*/
+#ifndef EVENTGENERATOR_H
+#define EVENTGENERATOR_H
+
+#include "Manager.h"
+#include <random>
+#include <set>
+
+namespace geotree{
+
+  /// One correlation in a generated event (same convention as Manager::AddCorrelation)
+  struct CorrelationRecord {
+    NodeID_t id1;
+    NodeID_t id2;
+    double score;
+    ::geoalgo::Point_t vtx;
+    ::geotree::RelationType_t type;
+  };
+
+  class EventGenerator{
+
+  public:
+
+    /// Default constructor
+    EventGenerator();
+
+    /// Default destructor
+    virtual ~EventGenerator(){}
+
+    /// Random seed. Same seed + same settings -> same sequence of events
+    void SetSeed(unsigned int seed) { _rand.seed(seed); }
+
+    /// Number of nodes in each event
+    void SetNodes(size_t n) { _n_nodes = n; }
+
+    /// Mean number of weak (random, low score) parent correlations per node
+    void SetCorrelationDensity(double d) { _density = d; }
+
+    /// Fraction of nodes that are primaries in the true forest
+    void SetPrimaryFraction(double f) { _f_primary = f; }
+
+    /// Fraction of non-primary nodes that get one or two extra parents
+    void SetMultipleParentFraction(double f) { _f_mult_parent = f; }
+
+    /// Fraction of non-primary nodes that also get a sibling
+    void SetParentSiblingFraction(double f) { _f_parent_sibling = f; }
+
+    /// Fraction of primary nodes that are put in a 3-sibling group
+    void SetMultipleSiblingFraction(double f) { _f_mult_sibling = f; }
+
+    /// Generate a new event
+    void Generate();
+
+    /// Load the current event in a manager (the manager is Reset first)
+    void Fill(Manager& mgr) const;
+
+    /// Getter for the node IDs of the current event
+    const std::vector<NodeID_t>& GetNodeIDs() const { return _IDs; }
+
+    /// Getter for the correlations of the current event
+    const std::vector<CorrelationRecord>& GetCorrelations() const { return _corr_v; }
+
+  private:
+
+    /// add a correlation if the two nodes are not correlated yet
+    bool Add(size_t i1, size_t i2, double score,
+	     const ::geoalgo::Point_t& vtx,
+	     const ::geotree::RelationType_t type);
+
+    /// random point in the detector volume
+    ::geoalgo::Point_t RandomPoint();
+
+    /// random point within dist of pt
+    ::geoalgo::Point_t Smear(const ::geoalgo::Point_t& pt, double dist);
+
+    /// uniform number in [min,max)
+    double Uniform(double min, double max);
+
+    size_t _n_nodes;
+    double _density;
+    double _f_primary;
+    double _f_mult_parent;
+    double _f_parent_sibling;
+    double _f_mult_sibling;
+
+    /// random engine
+    std::mt19937 _rand;
+
+    /// node IDs for this event
+    std::vector<NodeID_t> _IDs;
+
+    /// correlations for this event
+    std::vector<CorrelationRecord> _corr_v;
+
+    /// pairs (by index) already correlated
+    std::set< std::pair<size_t,size_t> > _pairs;
+
+  };
+}
+
+#endif
+/** @} */ // end of doxygen group
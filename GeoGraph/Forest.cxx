@@ -0,0 +1,284 @@
+#ifndef FOREST_CXX
+#define FOREST_CXX
+
+#include "Forest.h"
+#include "NodeCollection.h"
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <thread>
+
+namespace geotree{
+
+  const size_t Forest::kParallelRows;
+  const int Forest::kUnknown;
+  const int Forest::kWalking;
+
+
+  /// run fn(begin,end) on consecutive chunks of [0,n), one per thread
+  /// (the last one on the calling thread)
+  template <class F>
+  static void ParallelFor(size_t threads, size_t n, F fn){
+
+    if (threads < 2){
+      fn((size_t)0,n);
+      return;
+    }
+
+    size_t const chunk = (n+threads-1)/threads;
+    std::vector<std::thread> pool;
+    for (size_t b=0; b+chunk < n; b+=chunk)
+      pool.emplace_back(fn,b,b+chunk);
+    fn(pool.size()*chunk,n);
+    for (auto& t : pool)
+      t.join();
+
+    return;
+  }
+
+
+  void Forest::Build(const NodeCollection& coll, const std::vector<long>& parent,
+		     const std::vector<size_t>& heads, size_t event, size_t threads){
+
+    _event = event;
+
+    auto const& IDs = coll.GetNodeIDs();
+    size_t const nodes = IDs.size();
+    if ( (threads > 1) and (nodes < 2*kParallelRows) )
+      threads = 1;
+    if (threads > nodes/kParallelRows)
+      threads = std::max((size_t)1,nodes/kParallelRows);
+
+    _id.assign(IDs.begin(),IDs.end());
+    _parent.resize(nodes);
+    _depth.assign(nodes,kUnknown);
+    _vtx.resize(3*nodes);
+    _heads.clear();
+
+    // depth: 0 for the heads, one more than the parent below them.
+    // Each chain of parents is walked once (rows on the way are
+    // kept in _children, rebuilt below). Rows not below a head
+    // stay at -1 and get no parent
+    for (auto const& h : heads){
+      if (_depth[h] >= 0)
+	continue;
+      _depth[h] = 0;
+      _heads.push_back(h);
+    }
+    std::vector<size_t>& chain = _children;
+    for (size_t i=0; i < nodes; i++){
+      chain.clear();
+      size_t r = i;
+      while (_depth[r] == kUnknown){
+	chain.push_back(r);
+	_depth[r] = kWalking;
+	if (parent[r] < 0)
+	  break;
+	r = parent[r];
+      }
+      int d = (_depth[r] >= 0) ? _depth[r] : -1;
+      for (size_t k=chain.size(); k > 0; k--){
+	if (d >= 0) d += 1;
+	_depth[chain[k-1]] = d;
+      }
+    }
+    for (size_t i=0; i < nodes; i++)
+      _parent[i] = (_depth[i] > 0) ? parent[i] : -1;
+
+    // vertex each node comes from
+    ParallelFor(threads,nodes,[&](size_t begin, size_t end){
+	for (size_t i=begin; i < end; i++){
+	  const Node& node = coll.NodeAt(i);
+	  const CorrelationEntry* corr = nullptr;
+	  if (node.siblings().empty() == false)
+	    corr = &(node.siblings()[0]);
+	  else if (_parent[i] >= 0)
+	    corr = node.findCorrelation(_id[_parent[i]]);
+	  if ( (corr == nullptr) or (coll.Vertices().XYZ(corr->VtxID(),&_vtx[3*i]) == false) )
+	    for (size_t k=0; k < 3; k++)
+	      _vtx[3*i+k] = std::numeric_limits<double>::quiet_NaN();
+	}
+      });
+
+    // children (CSR): count per parent, prefix sum, scatter.
+    // Children of a row are in row order, which is the order
+    // MakeTree attached them in
+    _childOffset.assign(nodes+1,0);
+    if (threads < 2){
+      for (size_t i=0; i < nodes; i++)
+	if (_parent[i] >= 0) _childOffset[_parent[i]+1] += 1;
+      for (size_t i=0; i < nodes; i++)
+	_childOffset[i+1] += _childOffset[i];
+      // the offset of each row is its cursor: afterwards it is the
+      // offset of the next row, shifted back in place
+      _children.resize(_childOffset[nodes]);
+      for (size_t i=0; i < nodes; i++)
+	if (_parent[i] >= 0) _children[_childOffset[_parent[i]]++] = i;
+      for (size_t i=nodes; i > 0; i--)
+	_childOffset[i] = _childOffset[i-1];
+      _childOffset[0] = 0;
+    }
+    else
+      BuildChildren(threads);
+
+    // ID -> row
+    _index.resize(nodes);
+    for (size_t i=0; i < nodes; i++)
+      _index[i] = std::make_pair(_id[i],i);
+    std::sort(_index.begin(),_index.end());
+
+    return;
+  }
+
+
+  void Forest::BuildChildren(size_t threads){
+
+    size_t const nodes = _id.size();
+    std::unique_ptr< std::atomic<size_t>[] > count(new std::atomic<size_t>[nodes]);
+
+    // count
+    ParallelFor(threads,nodes,[&](size_t begin, size_t end){
+	for (size_t i=begin; i < end; i++)
+	  count[i].store(0,std::memory_order_relaxed);
+      });
+    ParallelFor(threads,nodes,[&](size_t begin, size_t end){
+	for (size_t i=begin; i < end; i++)
+	  if (_parent[i] >= 0) count[_parent[i]].fetch_add(1,std::memory_order_relaxed);
+      });
+
+    // prefix sum: chunk totals, then each chunk from its start
+    size_t const chunk = (nodes+threads-1)/threads;
+    std::vector<size_t> start(threads+1,0);
+    ParallelFor(threads,nodes,[&](size_t begin, size_t end){
+	size_t sum = 0;
+	for (size_t i=begin; i < end; i++)
+	  sum += count[i].load(std::memory_order_relaxed);
+	start[begin/chunk+1] = sum;
+      });
+    for (size_t t=0; t < threads; t++)
+      start[t+1] += start[t];
+    ParallelFor(threads,nodes,[&](size_t begin, size_t end){
+	size_t off = start[begin/chunk];
+	for (size_t i=begin; i < end; i++){
+	  size_t const n = count[i].load(std::memory_order_relaxed);
+	  _childOffset[i] = off;
+	  // count becomes the cursor of the scatter
+	  count[i].store(off,std::memory_order_relaxed);
+	  off += n;
+	}
+      });
+    _childOffset[nodes] = start[threads];
+
+    // scatter, then each row's children in row order
+    _children.resize(_childOffset[nodes]);
+    ParallelFor(threads,nodes,[&](size_t begin, size_t end){
+	for (size_t i=begin; i < end; i++)
+	  if (_parent[i] >= 0) _children[count[_parent[i]].fetch_add(1,std::memory_order_relaxed)] = i;
+      });
+    ParallelFor(threads,nodes,[&](size_t begin, size_t end){
+	for (size_t i=begin; i < end; i++)
+	  std::sort(_children.begin()+_childOffset[i],_children.begin()+_childOffset[i+1]);
+      });
+
+    return;
+  }
+
+
+  void Forest::BuildSubtree(const Forest& src, size_t row){
+
+    _event = src._event;
+
+    // rows of src in the subtree, parents first
+    // (_children is used as scratch: it is rebuilt below)
+    std::vector<size_t>& rows = _children;
+    rows.assign(1,row);
+    for (size_t i=0; i < rows.size(); i++)
+      for (auto const& c : src.Children(rows[i]))
+	rows.push_back(c);
+    size_t const nodes = rows.size();
+
+    // src row -> new row
+    _index.resize(nodes);
+    for (size_t i=0; i < nodes; i++)
+      _index[i] = std::make_pair((NodeID_t)rows[i],i);
+    std::sort(_index.begin(),_index.end());
+    auto newRow = [this](size_t r){
+      return std::lower_bound(_index.begin(),_index.end(),std::make_pair((NodeID_t)r,(size_t)0))->second;
+    };
+
+    _id.resize(nodes);
+    _parent.resize(nodes);
+    _depth.resize(nodes);
+    _vtx.resize(3*nodes);
+    for (size_t i=0; i < nodes; i++){
+      size_t const r = rows[i];
+      _id[i] = src._id[r];
+      _parent[i] = (i == 0) ? -1 : (long)newRow(src._parent[r]);
+      _depth[i]  = (i == 0) ? 0 : _depth[_parent[i]]+1;
+      for (size_t k=0; k < 3; k++)
+	_vtx[3*i+k] = src._vtx[3*r+k];
+    }
+    _heads.assign(1,0);
+
+    // children: in the walk every row's children are consecutive
+    _childOffset.assign(nodes+1,0);
+    for (size_t i=1; i < nodes; i++)
+      _childOffset[_parent[i]+1] += 1;
+    for (size_t i=0; i < nodes; i++)
+      _childOffset[i+1] += _childOffset[i];
+    _children.resize(nodes-1);
+    for (size_t i=1; i < nodes; i++)
+      _children[i-1] = i;
+
+    // ID -> row
+    for (size_t i=0; i < nodes; i++)
+      _index[i] = std::make_pair(_id[i],i);
+    std::sort(_index.begin(),_index.end());
+
+    return;
+  }
+
+
+  void Forest::Clear(){
+
+    _event = 0;
+    _id.clear();
+    _parent.clear();
+    _depth.clear();
+    _vtx.clear();
+    _heads.clear();
+    _childOffset.assign(1,0);
+    _children.clear();
+    _index.clear();
+
+    return;
+  }
+
+
+  bool Forest::FindRow(NodeID_t id, size_t& row) const {
+
+    auto it = std::lower_bound(_index.begin(),_index.end(),std::make_pair(id,(size_t)0));
+    if ( (it == _index.end()) or (it->first != id) )
+      return false;
+
+    row = it->second;
+    return true;
+  }
+
+
+  void Forest::AddMemoryUsage(MemoryUsage_t& usage) const {
+
+    usage.tree += _id.capacity()*sizeof(NodeID_t);
+    usage.tree += _parent.capacity()*sizeof(long);
+    usage.tree += _depth.capacity()*sizeof(int);
+    usage.tree += _vtx.capacity()*sizeof(double);
+    usage.tree += (_heads.capacity() + _childOffset.capacity() + _children.capacity())*sizeof(size_t);
+    usage.tree += _index.capacity()*sizeof(std::pair<NodeID_t,size_t>);
+
+    return;
+  }
+
+}
+
+#endif
@@ -0,0 +1,148 @@
+/**
+ * \file Forest.h
+ *
+ * \ingroup GeoTree
+ *
+ * \brief Class def header for a class geotree::Forest
+ *
+ * @author david caratelli
+ */
+
+/** \addtogroup GeoTree
+    Read-optimized copy of the forest made by Manager::MakeTree.
+    One row per node (same order as NodeCollection::GetNodeIDs),
+    flat arrays only: IDs, parent row, depth, vertex, children
+    rows (CSR) and head rows.
+    It is built from the parent row of each node and the head rows
+    as recorded by MakeTree: depths in one walk up the parent
+    chains, then the CSR children by a counting pass, a prefix sum
+    and a scatter. For large events (kParallelRows rows per thread
+    or more) the vertices and the CSR are built on several threads. A Forest does not refer to the
+    NodeCollection it was built from, so it stays valid after
+    the manager is Reset or moves on to the next event.
+    Published forests are read through ForestPublisher.
+    @{*/
+#ifndef FOREST_H
+#define FOREST_H
+
+#include "Node.h"
+#include <utility>
+#include <vector>
+
+namespace geotree{
+
+  class NodeCollection;
+
+  /**
+     \class geotree::Forest
+     Flat, immutable view of the trees of one event
+  */
+  class Forest{
+
+  public:
+
+    /// range over rows (children of a node)
+    class RowRange{
+    public:
+      RowRange(const size_t* begin, const size_t* end) : _begin(begin), _end(end) {}
+      const size_t* begin() const { return _begin; }
+      const size_t* end()   const { return _end; }
+      size_t size() const { return (size_t)(_end - _begin); }
+      bool empty() const { return (_begin == _end); }
+    private:
+      const size_t* _begin;
+      const size_t* _end;
+    };
+
+    Forest() : _event(0), _childOffset(1,0) {}
+
+    virtual ~Forest(){}
+
+    /// Replace the content with the trees of a collection (capacity
+    /// is kept). parent: parent row of each node (-1: none), heads:
+    /// head rows, in order (rows below no head get depth -1 and no
+    /// parent). event: number given to this forest. threads: at most
+    /// this many threads, only for events of 2*kParallelRows rows or more
+    void Build(const NodeCollection& coll, const std::vector<long>& parent,
+	       const std::vector<size_t>& heads, size_t event, size_t threads = 1);
+
+    /// rows per thread below which Build does not start threads
+    static const size_t kParallelRows = 16384;
+
+    /// Replace the content with the rows under one row of another
+    /// forest: that row becomes the only head (depth 0), the rows
+    /// below it keep their order of the walk from it (capacity is kept)
+    void BuildSubtree(const Forest& src, size_t row);
+
+    /// Remove all rows (capacity is kept)
+    void Clear();
+
+    /// number given to the forest when it was built
+    /// (Manager: one per MakeTree call, starting at 1)
+    size_t Event() const { return _event; }
+
+    /// number of rows (nodes)
+    size_t Size() const { return _id.size(); }
+
+    /// node ID of a row
+    NodeID_t ID(size_t row) const { return _id[row]; }
+
+    /// row of the parent node, -1 for head nodes and nodes not in the tree
+    long Parent(size_t row) const { return _parent[row]; }
+
+    /// 0 for head nodes, -1 for nodes not in the tree
+    int Depth(size_t row) const { return _depth[row]; }
+
+    /// vertex the node comes from (x,y,z; NaN if unknown):
+    /// the one shared with its siblings if it has any, otherwise
+    /// that of the correlation with its parent
+    const double* Vertex(size_t row) const { return _vtx.data()+3*row; }
+
+    /// rows of the children of a row
+    RowRange Children(size_t row) const
+    { return RowRange(_children.data()+_childOffset[row],_children.data()+_childOffset[row+1]); }
+
+    /// rows of the head nodes
+    const std::vector<size_t>& Heads() const { return _heads; }
+
+    /// the arrays themselves, for scans over all rows: parent row of
+    /// each row, and children of row r at ChildRows()[ChildOffsets()[r]
+    /// .. ChildOffsets()[r+1]) (Size()+1 offsets)
+    const std::vector<long>& Parents() const { return _parent; }
+    const std::vector<size_t>& ChildOffsets() const { return _childOffset; }
+    const std::vector<size_t>& ChildRows() const { return _children; }
+
+    /// row of a node ID (binary search). false if the ID is not in the forest
+    bool FindRow(NodeID_t id, size_t& row) const;
+
+    /// Add the memory held by the forest to a report
+    void AddMemoryUsage(MemoryUsage_t& usage) const;
+
+  private:
+
+    /// depth while building: not known yet / on the chain being walked
+    static const int kUnknown = -2;
+    static const int kWalking = -3;
+
+    /// CSR children on several threads (atomic counts)
+    void BuildChildren(size_t threads);
+
+    size_t _event;
+
+    std::vector<NodeID_t> _id;
+    std::vector<long> _parent;
+    std::vector<int> _depth;
+    std::vector<double> _vtx;
+    std::vector<size_t> _heads;
+    /// children of row r: _children[_childOffset[r] .. _childOffset[r+1])
+    std::vector<size_t> _childOffset;
+    std::vector<size_t> _children;
+    /// (ID, row) sorted by ID
+    std::vector< std::pair<NodeID_t,size_t> > _index;
+
+  };
+
+}
+
+#endif
+/** @} */ // end of doxygen group
@@ -0,0 +1,89 @@
+#ifndef FORESTPUBLISHER_CXX
+#define FORESTPUBLISHER_CXX
+
+#include "ForestPublisher.h"
+
+namespace geotree{
+
+  const size_t ForestPublisher::kNone;
+
+
+  ForestPublisher::ForestPublisher(size_t slots)
+    : _nslots(slots < 2 ? 2 : slots)
+    , _slots(new Forest[_nslots])
+    , _readers(new std::atomic<unsigned int>[_nslots])
+    , _current(kNone)
+  {
+    for (size_t i=0; i < _nslots; i++)
+      _readers[i].store(0);
+  }
+
+
+  ForestPublisher::Reader ForestPublisher::Read() const {
+
+    while (true){
+      size_t const slot = _current.load();
+      if (slot == kNone)
+	return Reader();
+      _readers[slot].fetch_add(1);
+      // still current: the writer cannot take the slot any more
+      if (_current.load() == slot)
+	return Reader(this,slot);
+      // a new forest was published in the meantime
+      _readers[slot].fetch_sub(1);
+    }
+  }
+
+
+  bool ForestPublisher::Publish(const Forest& forest){
+
+    size_t const current = _current.load();
+
+    for (size_t i=0; i < _nslots; i++){
+      if ( (i == current) or (_readers[i].load() != 0) )
+	continue;
+      // a reader that registers on this slot from now on finds
+      // that it is not current and lets go
+      _slots[i] = forest;
+      _current.store(i);
+      return true;
+    }
+
+    return false;
+  }
+
+
+  void ForestPublisher::AddMemoryUsage(MemoryUsage_t& usage) const {
+
+    for (size_t i=0; i < _nslots; i++)
+      _slots[i].AddMemoryUsage(usage);
+
+    return;
+  }
+
+
+  ForestPublisher::Reader& ForestPublisher::Reader::operator=(Reader&& other){
+
+    if (this != &other){
+      Release();
+      _pub  = other._pub;
+      _slot = other._slot;
+      other._pub = nullptr;
+    }
+
+    return *this;
+  }
+
+
+  void ForestPublisher::Reader::Release(){
+
+    if (_pub != nullptr)
+      _pub->_readers[_slot].fetch_sub(1);
+    _pub = nullptr;
+
+    return;
+  }
+
+}
+
+#endif
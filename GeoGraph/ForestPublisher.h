@@ -0,0 +1,112 @@
+/**
+ * \file ForestPublisher.h
+ *
+ * \ingroup GeoTree
+ *
+ * \brief Class def header for a class geotree::ForestPublisher
+ *
+ * @author david caratelli
+ */
+
+/** \addtogroup GeoTree
+    Publishes the latest Forest of a Manager to reader threads
+    (monitoring, selection) while the manager goes on with the
+    next event.
+    - A fixed number of slots, each holding one Forest and a
+      count of the readers using it, plus the index of the
+      current slot.
+    - Read() (any thread, lock-free): increments the count of
+      the current slot, then checks that the slot is still
+      current (otherwise it lets go and tries again). The
+      returned Reader keeps the slot until it is destroyed.
+    - Publish() (one writer thread): copies the forest into a
+      slot that is not current and has no readers (capacity of
+      the slot is reused), then makes it current. The writer
+      never waits: if every other slot is held by readers the
+      forest is not published (Publish returns false) and
+      readers keep seeing the previous one.
+    A slot is only written when its reader count is 0 and it is
+    not current; a reader only uses a slot that was current after
+    it registered, so it never sees a forest being written.
+    Usage (reader thread):
+    auto f = mgr.GetForest();
+    if (f) for (auto row : f->Heads()) ...
+    @{*/
+#ifndef FORESTPUBLISHER_H
+#define FORESTPUBLISHER_H
+
+#include "Forest.h"
+#include <atomic>
+#include <memory>
+
+namespace geotree{
+
+  /**
+     \class geotree::ForestPublisher
+     Lock-free publication of forests to concurrent readers
+  */
+  class ForestPublisher{
+
+  public:
+
+    /// Handle on a published forest: the forest does not change
+    /// while the handle exists. Move-only
+    class Reader{
+    public:
+      Reader() : _pub(nullptr), _slot(0) {}
+      Reader(Reader&& other) : _pub(other._pub), _slot(other._slot) { other._pub = nullptr; }
+      Reader& operator=(Reader&& other);
+      ~Reader() { Release(); }
+      /// let go of the forest (the handle is empty afterwards)
+      void Release();
+      /// false if nothing was published yet
+      explicit operator bool() const { return (_pub != nullptr); }
+      const Forest& operator*()  const { return _pub->_slots[_slot]; }
+      const Forest* operator->() const { return &(_pub->_slots[_slot]); }
+    private:
+      friend class ForestPublisher;
+      Reader(const ForestPublisher* pub, size_t slot) : _pub(pub), _slot(slot) {}
+      Reader(const Reader&);
+      Reader& operator=(const Reader&);
+      const ForestPublisher* _pub;
+      size_t _slot;
+    };
+
+    /// slots: number of forests kept (at least 2)
+    ForestPublisher(size_t slots = 4);
+
+    virtual ~ForestPublisher(){}
+
+    /// Latest published forest (empty handle if none). Any thread, lock-free
+    Reader Read() const;
+
+    /// Publish a copy of a forest. Writer thread only, never waits.
+    /// false if no slot was free (nothing published)
+    bool Publish(const Forest& forest);
+
+    /// number of slots
+    size_t Slots() const { return _nslots; }
+
+    /// Add the memory held by the slots to a report
+    void AddMemoryUsage(MemoryUsage_t& usage) const;
+
+  private:
+
+    static const size_t kNone = (size_t)-1;
+
+    ForestPublisher(const ForestPublisher&);
+    ForestPublisher& operator=(const ForestPublisher&);
+
+    size_t _nslots;
+    std::unique_ptr<Forest[]> _slots;
+    /// readers using each slot
+    std::unique_ptr< std::atomic<unsigned int>[] > _readers;
+    /// slot of the latest forest (kNone: nothing published)
+    std::atomic<size_t> _current;
+
+  };
+
+}
+
+#endif
+/** @} */ // end of doxygen group
@@ -0,0 +1,46 @@
+/**
+ * \file Invariants.h
+ *
+ * \ingroup GeoTree
+ *
+ * \brief Invariant checks of the trusted mutation paths
+ *
+ * @author david caratelli
+ */
+
+/** \addtogroup GeoTree
+    The trusted mutations (Node::editAt / insertCorrelation /
+    eraseAt, and the Manager's TrustedSet / TrustedErase used by
+    ApplyAlgoCorrelations) take nodes and entry positions that
+    the caller already resolved, and do not validate them again.
+    Their preconditions are written as GEOTREE_CHECK(cond,msg),
+    which throws a GeoAlgoException when cond is false and is
+    compiled in when GEOTREE_CHECKED is defined. That is the case
+    by default, in builds without -DNDEBUG, and in address / thread
+    sanitizer builds; a release build (-DNDEBUG, see GNUmakefile)
+    drops the checks. -DGEOTREE_CHECKED keeps them in any build.
+    @{*/
+#ifndef INVARIANTS_H
+#define INVARIANTS_H
+
+#include "GeoAlgo/GeoAlgoException.h"
+
+#if !defined(GEOTREE_CHECKED)
+#if !defined(NDEBUG) || defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+#define GEOTREE_CHECKED
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(thread_sanitizer)
+#define GEOTREE_CHECKED
+#endif
+#endif
+#endif
+
+#ifdef GEOTREE_CHECKED
+#define GEOTREE_CHECK(COND,MSG) \
+  do { if (!(COND)) throw ::geoalgo::GeoAlgoException(MSG); } while(0)
+#else
+#define GEOTREE_CHECK(COND,MSG) do { } while(0)
+#endif
+
+#endif
+/** @} */ // end of doxygen group
@@ -24,6 +24,31 @@
 #pragma link C++ class geotree::AlgoGenericConflictRemoveSibling+;
 #pragma link C++ class geotree::AlgoGenericConflictFindHighestScore+;
 #pragma link C++ class geotree::AlgoSibHasDiffParent+;
+#pragma link C++ class geotree::EventGenerator+;
+#pragma link C++ class geotree::LatencyHistogram+;
+#pragma link C++ class geotree::ManagerStats+;
+#pragma link C++ class geotree::MemoryUsage_t+;
+#pragma link C++ class geotree::Pipeline;
+#pragma link C++ class geotree::UndoLog+;
+#pragma link C++ class geotree::PruneConfig+;
+#pragma link C++ class geotree::BeamHypothesis+;
+#pragma link C++ class geotree::BeamSearch+;
+#pragma link C++ namespace geotree::msg;
+#pragma link C++ class geotree::Logger;
+#pragma link C++ class geotree::VertexTable+;
+#pragma link C++ class geotree::SiblingGroups+;
+#pragma link C++ class geotree::SiblingGroups::MemberRange;
+#pragma link C++ class geotree::SiblingMatching+;
+#pragma link C++ class geotree::ConflictCensus+;
+#pragma link C++ class geotree::CorrelationEntry+;
+#pragma link C++ class geotree::RelationRange;
+#pragma link C++ class geotree::CycleEdge_t+;
+#pragma link C++ class std::vector<geotree::CycleEdge_t>+;
+#pragma link C++ class geotree::Forest+;
+#pragma link C++ class geotree::Forest::RowRange;
+#pragma link C++ class geotree::ForestPublisher;
+#pragma link C++ class geotree::ForestPublisher::Reader;
+#pragma link C++ class geotree::SmallVector<size_t,4>;
 #pragma link C++ class std::vector<geotree::Node>+;
 //ADD_NEW_CLASS ... do not change this line
 #endif
@@ -0,0 +1,191 @@
+#ifndef LOGGER_CXX
+#define LOGGER_CXX
+
+#include "Logger.h"
+
+namespace geotree{
+
+  std::atomic<int> Logger::_levels[msg::kNSubsystems] = { {msg::kNORMAL}, {msg::kNORMAL}, {msg::kNORMAL}, {msg::kNORMAL} };
+  std::atomic<int> Logger::_scopes(0);
+  std::ostream* Logger::_sink = &std::cout;
+
+  // level overrides of the calling thread, per subsystem
+  // (-1: none), see Logger::Scope
+  static thread_local int gScopeLevel[msg::kNSubsystems] = { -1, -1, -1, -1 };
+  std::mutex Logger::_sink_mutex;
+
+  // streambuf appending to the ring slot being written
+  class LogStringBuf : public std::streambuf{
+  public:
+    LogStringBuf() : _target(nullptr) {}
+    void SetTarget(std::string* target) { _target = target; }
+  protected:
+    int_type overflow(int_type c)
+    {
+      if (c != traits_type::eof()) _target->push_back((char)c);
+      return c;
+    }
+    std::streamsize xsputn(const char* s, std::streamsize n)
+    {
+      _target->append(s,n);
+      return n;
+    }
+  private:
+    std::string* _target;
+  };
+
+  // Lines keep their capacity once used: after warm-up
+  // writing a message does not allocate
+  class Logger::Ring{
+  public:
+    Ring() : _lines(kRingSize), _n(0), _os(&_buf) {}
+    ~Ring() { Flush(); }
+
+    void Begin(msg::Subsystem_t sub, msg::Level_t lvl)
+    {
+      _lines[_n].text.clear();
+      _lines[_n].sub = sub;
+      _lines[_n].lvl = lvl;
+      _buf.SetTarget(&_lines[_n].text);
+    }
+
+    std::ostream& Stream() { return _os; }
+
+    void Commit()
+    {
+      _lines[_n].text.push_back('\n');
+      _n += 1;
+      if (_n == kRingSize)
+	Flush();
+    }
+
+    void Flush()
+    {
+      if (_n == 0)
+	return;
+      std::lock_guard<std::mutex> lock(Logger::_sink_mutex);
+      for (size_t i=0; i < _n; i++)
+	(*_sink) << "[" << Logger::LevelName(_lines[i].lvl) << "] ["
+		 << Logger::SubsystemName(_lines[i].sub) << "] " << _lines[i].text;
+      _sink->flush();
+      _n = 0;
+    }
+
+  private:
+    struct Line_t {
+      std::string text;
+      msg::Subsystem_t sub;
+      msg::Level_t lvl;
+    };
+    std::vector<Line_t> _lines;
+    size_t _n;
+    LogStringBuf _buf;
+    std::ostream _os;
+  };
+
+  Logger::Ring& Logger::ThreadRing()
+  {
+    static thread_local Ring ring;
+    return ring;
+  }
+
+  void Logger::SetLevel(msg::Level_t lvl)
+  {
+    for (size_t i=0; i < msg::kNSubsystems; i++)
+      SetLevel((msg::Subsystem_t)i,lvl);
+  }
+
+  bool Logger::EnabledInScope(msg::Subsystem_t sub, msg::Level_t lvl)
+  {
+    if (gScopeLevel[sub] >= 0)
+      return (int)lvl >= gScopeLevel[sub];
+    return (int)lvl >= _levels[sub].load(std::memory_order_relaxed);
+  }
+
+  const char* Logger::LevelName(msg::Level_t lvl)
+  {
+    switch (lvl){
+    case msg::kDEBUG:   return "DEBUG";
+    case msg::kINFO:    return "INFO";
+    case msg::kNORMAL:  return "NORMAL";
+    case msg::kWARNING: return "WARNING";
+    case msg::kERROR:   return "ERROR";
+    default:            return "NONE";
+    }
+  }
+
+  const char* Logger::SubsystemName(msg::Subsystem_t sub)
+  {
+    switch (sub){
+    case msg::kManager:    return "Manager";
+    case msg::kNode:       return "Node";
+    case msg::kCollection: return "NodeCollection";
+    case msg::kAlgo:       return "Algo";
+    default:               return "?";
+    }
+  }
+
+  Logger::Scope::Scope(int lvl)
+    : _sub(-1)
+    , _set(lvl >= 0)
+  {
+    if (_set == false)
+      return;
+    for (size_t i=0; i < msg::kNSubsystems; i++){
+      _prev[i] = gScopeLevel[i];
+      gScopeLevel[i] = lvl;
+    }
+    _scopes.fetch_add(1,std::memory_order_relaxed);
+  }
+
+  Logger::Scope::Scope(msg::Subsystem_t sub, int lvl)
+    : _sub(sub)
+    , _set(lvl >= 0)
+  {
+    if (_set == false)
+      return;
+    _prev[sub] = gScopeLevel[sub];
+    gScopeLevel[sub] = lvl;
+    _scopes.fetch_add(1,std::memory_order_relaxed);
+  }
+
+  Logger::Scope::~Scope()
+  {
+    if (_set == false)
+      return;
+    for (size_t i=0; i < msg::kNSubsystems; i++)
+      if ( (_sub < 0) or ((int)i == _sub) )
+	gScopeLevel[i] = _prev[i];
+    _scopes.fetch_sub(1,std::memory_order_relaxed);
+  }
+
+  void Logger::SetSink(std::ostream* out)
+  {
+    std::lock_guard<std::mutex> lock(_sink_mutex);
+    _sink = out;
+  }
+
+  void Logger::Flush()
+  {
+    ThreadRing().Flush();
+  }
+
+  LogLine::LogLine(msg::Subsystem_t sub, msg::Level_t lvl)
+    : _ring(Logger::ThreadRing())
+  {
+    _ring.Begin(sub,lvl);
+  }
+
+  LogLine::~LogLine()
+  {
+    _ring.Commit();
+  }
+
+  std::ostream& LogLine::Stream()
+  {
+    return _ring.Stream();
+  }
+
+}
+
+#endif
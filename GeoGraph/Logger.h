@@ -0,0 +1,185 @@
+/**
+ * \file Logger.h
+ *
+ * \ingroup GeoTree
+ *
+ * \brief Class def header for a class geotree::Logger
+ *
+ * @author david caratelli
+ */
+
+/** \addtogroup GeoTree
+    Leveled logging for GeoTree.
+    - Levels below GEOTREE_LOG_MIN_LEVEL (compile time, default
+      kDEBUG) are removed by the compiler: the message is never
+      formatted and the check itself disappears.
+    - Above that, each subsystem (Manager, Node, NodeCollection,
+      Algo) has its own runtime level, shared by all threads.
+    - A Logger::Scope overrides the level of every subsystem, or
+      of one, on the calling thread while it lives. Manager and
+      AlgoBase SetVerbose use it, so that the verbosity of one
+      Manager or algorithm does not change that of the others
+      (other Managers of a pipeline included).
+    - Messages are written to a per-thread ring of lines which is
+      written to the sink in one go when full, when Flush() is
+      called, or when the thread ends. Manager flushes at the end
+      of ResolveConflicts and MakeTree. Each line is written with
+      its level and subsystem: "[DEBUG] [Manager] ..." 
+    Usage:
+    GEOTREE_DEBUG(msg::kManager, "node " << ID << " has parent");
+    @{*/
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace geotree{
+
+  namespace msg{
+
+    /// Message levels
+    enum Level_t {
+      kDEBUG,
+      kINFO,
+      kNORMAL,
+      kWARNING,
+      kERROR,
+      kNONE
+    };
+
+    /// Subsystems with an independent runtime level
+    enum Subsystem_t {
+      kManager,
+      kNode,
+      kCollection,
+      kAlgo,
+      kNSubsystems
+    };
+  }
+
+  /**
+     \class geotree::Logger
+     Runtime levels and output sink shared by all threads
+  */
+  class Logger{
+
+  public:
+
+    /// Set the runtime level of one subsystem
+    static void SetLevel(msg::Subsystem_t sub, msg::Level_t lvl) { _levels[sub].store(lvl,std::memory_order_relaxed); }
+
+    /// Set the runtime level of all subsystems
+    static void SetLevel(msg::Level_t lvl);
+
+    /// Runtime level of a subsystem
+    static msg::Level_t Level(msg::Subsystem_t sub) { return (msg::Level_t)_levels[sub].load(std::memory_order_relaxed); }
+
+    /// Is a level active for a subsystem (on the calling thread)?
+    static bool Enabled(msg::Subsystem_t sub, msg::Level_t lvl)
+    {
+      if (_scopes.load(std::memory_order_relaxed) != 0)
+	return EnabledInScope(sub,lvl);
+      return (int)lvl >= _levels[sub].load(std::memory_order_relaxed);
+    }
+
+    /// Names used to tag the lines
+    static const char* LevelName(msg::Level_t lvl);
+    static const char* SubsystemName(msg::Subsystem_t sub);
+
+    /**
+       \class geotree::Logger::Scope
+       Level of every subsystem (or of one) on the calling thread
+       while the scope lives (a negative level: no override).
+       Scopes nest: the innermost override of a subsystem wins
+    */
+    class Scope{
+    public:
+      Scope(int lvl);
+      Scope(msg::Subsystem_t sub, int lvl);
+      ~Scope();
+    private:
+      /// subsystem overridden (-1: all)
+      int _sub;
+      int _prev[msg::kNSubsystems];
+      bool _set;
+      Scope(const Scope&);
+      Scope& operator=(const Scope&);
+    };
+
+    /// Where buffered lines are written (default std::cout)
+    static void SetSink(std::ostream* out);
+
+    /// Write the lines buffered by the calling thread
+    static void Flush();
+
+    /// Number of lines each thread buffers before writing them out
+    static const size_t kRingSize = 256;
+
+  private:
+
+    friend class LogLine;
+
+    /// per-thread ring of lines (defined in Logger.cxx)
+    class Ring;
+
+    /// ring of the calling thread
+    static Ring& ThreadRing();
+
+    /// Enabled() while some thread has a Scope
+    static bool EnabledInScope(msg::Subsystem_t sub, msg::Level_t lvl);
+
+    static std::atomic<int> _levels[msg::kNSubsystems];
+    /// number of live Scopes (all threads)
+    static std::atomic<int> _scopes;
+    static std::ostream* _sink;
+    static std::mutex _sink_mutex;
+
+  };
+
+  /**
+     \class geotree::LogLine
+     One message: formatted directly in a slot of the
+     calling thread's ring, committed on destruction
+  */
+  class LogLine{
+
+  public:
+
+    LogLine(msg::Subsystem_t sub, msg::Level_t lvl);
+    ~LogLine();
+
+    std::ostream& Stream();
+
+  private:
+
+    Logger::Ring& _ring;
+
+    LogLine(const LogLine&);
+    LogLine& operator=(const LogLine&);
+
+  };
+
+}
+
+#ifndef GEOTREE_LOG_MIN_LEVEL
+#define GEOTREE_LOG_MIN_LEVEL 0
+#endif
+
+/// true if a message at this level would be written (constant false below the compile-time level)
+#define GEOTREE_LOG_ENABLED(SUB,LVL) \
+  ( ((int)(LVL) >= GEOTREE_LOG_MIN_LEVEL) && ::geotree::Logger::Enabled(SUB,LVL) )
+
+#define GEOTREE_LOG(SUB,LVL,MSG)					\
+  do { if (GEOTREE_LOG_ENABLED(SUB,LVL)) { ::geotree::LogLine geotree_log_line_(SUB,LVL); geotree_log_line_.Stream() << MSG; } } while(0)
+
+#define GEOTREE_DEBUG(SUB,MSG)   GEOTREE_LOG(SUB,::geotree::msg::kDEBUG,MSG)
+#define GEOTREE_INFO(SUB,MSG)    GEOTREE_LOG(SUB,::geotree::msg::kINFO,MSG)
+#define GEOTREE_WARNING(SUB,MSG) GEOTREE_LOG(SUB,::geotree::msg::kWARNING,MSG)
+#define GEOTREE_ERROR(SUB,MSG)   GEOTREE_LOG(SUB,::geotree::msg::kERROR,MSG)
+
+#endif
+/** @} */ // end of doxygen group
@@ -2,9 +2,13 @@
 #define MANAGER_CXX
 
 #include "Manager.h"
+#include <algorithm>
+#include <limits>
 
 namespace geotree{
 
+  const size_t Manager::kNoComponent;
+
 
   // Constructor
   Manager::Manager()
@@ -13,8 +17,14 @@ namespace geotree{
     , _algoGenericConflict(nullptr)
   {
     
-    _verbose = false;
     _loose   = false;
+    _sibling_matching = false;
+    _conflict_census = true;
+    _log_level = -1;
+    _track_memory = false;
+    _forest_event = 0;
+    _forest_threads = 1;
+    _publish = true;
 
     // Initialize algorithms used
     if (_algoMultipleParents) { delete _algoMultipleParents; }
@@ -28,16 +38,262 @@ namespace geotree{
 
   }
   
+  void Manager::Reset(){
+
+    UpdatePeakMemory();
+    _undo.Clear();
+    _coll.Reset();
+    _census.Clear();
+    _forest.Clear();
+    InvalidateLazy();
+
+    return;
+  }
+
+
+  void Manager::Reserve(size_t nodes, size_t correlations){
+
+    // each correlation is stored on both of its nodes
+    size_t const perNode = (nodes > 0) ? (2*correlations + nodes - 1)/nodes : 0;
+    _coll.Reserve(nodes,perNode);
+
+    return;
+  }
+
+
+  MemoryUsage_t Manager::MemoryUsage() const {
+
+    MemoryUsage_t usage;
+    _coll.AddMemoryUsage(usage);
+    _algoMultipleParents->AddMemoryUsage(usage);
+    _algoParentIsSiblingsSibling->AddMemoryUsage(usage);
+    _algoGenericConflict->AddMemoryUsage(usage);
+    _undo.AddMemoryUsage(usage);
+    _siblings.AddMemoryUsage(usage);
+    _matching.AddMemoryUsage(usage);
+    usage.scratch += _tree_ids.capacity()*sizeof(NodeID_t) + _tree_parent.capacity()*sizeof(long)
+      + _tree_heads.capacity()*sizeof(size_t) + _tree_added.capacity()/8
+      + _group_vtx.capacity()*sizeof(VertexID_t)
+      + _group_scratch.capacity()*sizeof(std::pair<VertexID_t,VertexID_t>);
+    _cycles.AddMemoryUsage(usage);
+    _forest.AddMemoryUsage(usage);
+    _published.AddMemoryUsage(usage);
+    for (auto const& comp : _lazy){
+      comp.forest.AddMemoryUsage(usage);
+      usage.scratch += comp.positions.capacity()*sizeof(size_t);
+    }
+    usage.scratch += _lazy_of.capacity()*sizeof(size_t);
+    _subtree.AddMemoryUsage(usage);
+
+    return usage;
+  }
+
+
+  void Manager::Rollback(){
+
+    size_t const restored = _undo.Rollback(_coll);
+    InvalidateLazy();
+    _stats.Count(ManagerStats::kUndoneCorrelation,restored);
+
+    return;
+  }
+
+
+  void Manager::SaveUndo(const NodeID_t id1, const NodeID_t id2,
+			 const Node* node1, const Node* node2){
+
+    if (_undo.Active())
+      _undo.Save(id1,id2,node1->findCorrelation(id2),node2->findCorrelation(id1));
+
+    return;
+  }
+
+
+  void Manager::Touched(const NodeID_t id1, const NodeID_t id2) noexcept {
+
+    if ( (_census.Active() == false) and _lazy_of.empty() )
+      return;
+
+    // nodes exist: checked by the caller
+    TouchedAt(_coll.FindIndex(id1),_coll.FindIndex(id2));
+
+    return;
+  }
+
+
+  void Manager::TouchedAt(size_t pos1, size_t pos2) noexcept {
+
+    if ( (_census.Active() == false) and _lazy_of.empty() )
+      return;
+
+    _census.Touch(pos1);
+    _census.Touch(pos2);
+    InvalidateLazy(pos1);
+    InvalidateLazy(pos2);
+
+    return;
+  }
+
+
+  const Forest& Manager::Subtree(NodeID_t root){
+
+    const Forest& forest = LazyForest(root);
+    size_t row = 0;
+    forest.FindRow(root,row);
+    _subtree.BuildSubtree(forest,row);
+
+    return _subtree;
+  }
+
+
+  const Forest& Manager::TreeOf(NodeID_t id){
+
+    const Forest& forest = LazyForest(id);
+    size_t row = 0;
+    forest.FindRow(id,row);
+    while (forest.Parent(row) >= 0)
+      row = forest.Parent(row);
+    _subtree.BuildSubtree(forest,row);
+
+    return _subtree;
+  }
+
+
+  const Forest& Manager::LazyForest(NodeID_t id){
+
+    Logger::Scope log(_log_level);
+
+    if (_coll.NodeExists(id) == false)
+      throw ::geoalgo::GeoAlgoException(Form("Lazy tree: node %i does not exist",(int)id));
+
+    size_t const pos = _coll.FindIndex(id);
+    if (_lazy_of.size() < _coll.NodeCount())
+      _lazy_of.resize(_coll.NodeCount(),kNoComponent);
+
+    if (_lazy_of[pos] != kNoComponent){
+      _stats.Count(ManagerStats::kLazyTreeCached);
+      return _lazy[_lazy_of[pos]].forest;
+    }
+
+    // free slot
+    size_t slot = 0;
+    while ( (slot < _lazy.size()) and _lazy[slot].valid )
+      slot++;
+    if (slot == _lazy.size())
+      _lazy.emplace_back();
+    LazyComponent_t& comp = _lazy[slot];
+
+    // the component: breadth-first over correlations of any type
+    // (a component is closed: no member belongs to another one)
+    auto& positions = comp.positions;
+    positions.assign(1,pos);
+    _lazy_of[pos] = slot;
+    for (size_t i=0; i < positions.size(); i++){
+      for (auto const& c : _coll.NodeAt(positions[i]).correlations()){
+	size_t const other = _coll.FindIndex(c.ID());
+	if (_lazy_of[other] == slot)
+	  continue;
+	_lazy_of[other] = slot;
+	positions.push_back(other);
+      }
+    }
+    // node order, as in a pass over the whole event
+    std::sort(positions.begin(),positions.end());
+
+    GEOTREE_DEBUG(msg::kManager, "Lazy tree of node " << id << ": " << positions.size() << " nodes");
+
+    // resolve the component on its own (its nodes are shared
+    // until the helper modifies them)
+    if (!_lazy_mgr){
+      _lazy_mgr.reset(new Manager());
+      _lazy_mgr->setPublishing(false);
+      _lazy_mgr->setMemoryTracking(false);
+    }
+    _lazy_mgr->_coll.Extract(_coll,positions);
+    _lazy_mgr->setLoose(_loose);
+    _lazy_mgr->setSiblingMatching(_sibling_matching);
+    _lazy_mgr->setConflictCensus(_conflict_census);
+    _lazy_mgr->setPruning(_prune);
+    try{
+      _lazy_mgr->ResolveConflicts();
+      _lazy_mgr->MakeTree();
+    }
+    catch (...){
+      for (auto const& p : positions)
+	_lazy_of[p] = kNoComponent;
+      _lazy_mgr->Reset();
+      throw;
+    }
+    comp.forest = _lazy_mgr->_forest;
+    comp.valid  = true;
+
+    // timers and counters of the component go to this manager;
+    // the helper lets go of the shared nodes
+    _stats.Merge(_lazy_mgr->_stats);
+    _lazy_mgr->_stats.Reset();
+    _lazy_mgr->Reset();
+    _stats.Count(ManagerStats::kLazyTreeBuilt);
+
+    return comp.forest;
+  }
+
+
+  void Manager::InvalidateLazy(){
+
+    if (_lazy_of.empty())
+      return;
+
+    for (auto& comp : _lazy){
+      if (comp.valid)
+	_stats.Count(ManagerStats::kLazyTreeInvalidated);
+      comp.valid = false;
+    }
+    _lazy_of.clear();
+
+    return;
+  }
+
+
+  void Manager::InvalidateLazy(size_t pos) noexcept {
+
+    if ( (pos >= _lazy_of.size()) or (_lazy_of[pos] == kNoComponent) )
+      return;
+
+    LazyComponent_t& comp = _lazy[_lazy_of[pos]];
+    for (auto const& p : comp.positions)
+      _lazy_of[p] = kNoComponent;
+    comp.valid = false;
+    _stats.Count(ManagerStats::kLazyTreeInvalidated);
+
+    return;
+  }
+
+
+  void Manager::UpdatePeakMemory(){
+
+    if (_track_memory == false)
+      return;
+
+    MemoryUsage_t const usage = MemoryUsage();
+    if (usage.Total() > _peak_memory.Total())
+      _peak_memory = usage;
+
+    return;
+  }
+
+
   // Node initializer: create a node for each object
   void Manager::setObjects(size_t n){
+
+    Logger::Scope log(_log_level);
   
-    if (_verbose) { std::cout << "Setting " << n << " objects to prepare tree" << std::endl; }
+    GEOTREE_DEBUG(msg::kManager, "Setting " << n << " objects to prepare tree");
     //_node_v.resize(_node_v.size()+n);
     for (size_t i=0; i < n; i++){
       // Assign an ID double the element number. Just because
       size_t nID = i*2;
       _coll.AddNode(nID);
-      if (_verbose) { std::cout << "Created Node Num. " << i << "/" << n <<" with ID " << nID << std::endl; }
+      GEOTREE_DEBUG(msg::kManager, "Created Node Num. " << i << "/" << n <<" with ID " << nID);
     }
 
     return;
@@ -47,45 +303,86 @@ namespace geotree{
   // Function to be called when Trees will be made
   void Manager::MakeTree(){
 
-    if (_verbose) { std::cout << "Making tree" << std::endl; }
+    Logger::Scope log(_log_level);
+
+    ManagerStats::ScopedTimer timer(_stats,ManagerStats::kMakeTree);
+
+    GEOTREE_DEBUG(msg::kManager, "Making tree");
+
+    if (_undo.Active())
+      throw ::geoalgo::GeoAlgoException("MakeTree: cannot make the tree inside a transaction (Commit or Rollback first)");
+
+    // the tree nodes and correlations change
+    InvalidateLazy();
+
+    // a cycle of parents cannot be made into a tree
+    BreakCycles();
 
     // clear the return collection storing the tree
     _coll.ClearTree();
 
+    // sibling groups: nodes linked by sibling correlations,
+    // formed in one pass over the correlations
+    // (a copy of the IDs: the vector grows with the synthetic nodes)
+    _tree_ids.assign(_coll.GetNodeIDs().begin(),_coll.GetNodeIDs().end());
+    auto const& IDs = _tree_ids;
+    size_t const nodes = IDs.size();
+    _siblings.Reset(nodes);
+    for (size_t i=0; i < nodes; i++){
+      for (auto const& s : _coll.FindNode(IDs[i])->siblings())
+	_siblings.Merge(i,_coll.FindIndex(s.ID()));
+    }
+    _siblings.Index();
+
     // loop over nodes.
     // what to do:
     // 1) if no parent or sibling -> add as head node
     // 2) if parent exists, add as child to that parent
     // 3) if sibling exists, create new parent node (example: pi0)
 
-    for (size_t n=0; n < _coll.GetNodeIDs().size(); n++){
+    // The forest is recorded by node position as it is made: parent
+    // position of each node and head positions. A node is already in
+    // the tree when it was put in the sibling group of an earlier node
+    // (the nodes made here for sibling groups are head nodes already)
+    _tree_parent.assign(nodes,-1);
+    _tree_heads.clear();
+    _tree_added.assign(nodes,false);
+    for (size_t n=0; n < nodes; n++){
 
-      NodeID_t ID = _coll.GetNodeIDs()[n];
+      NodeID_t ID = IDs[n];
 
-      if (_verbose) { std::cout << "Examining node " << n << " with ID: " << ID << std::endl; }
+      GEOTREE_DEBUG(msg::kManager, "Examining node " << n << " with ID: " << ID);
 
       // check if this node has been already added to the tree
-      if ( _coll.NodeAdded(ID) ){
-	if (_verbose) { std::cout << "\tthis node has already been added. Skip" << std::endl; }
+      if ( _tree_added[n] ){
+	GEOTREE_DEBUG(msg::kManager, "\tthis node has already been added. Skip");
 	continue;
       }
 
+      const Node& node = *_coll.FindNode(ID);
+
       // check if node is primary
-      if (_coll.GetNode(ID).isPrimary()){
-	if (_verbose) { std::cout << "\tnode is primary" << std::endl; }
+      if (node.isPrimary()){
+	GEOTREE_DEBUG(msg::kManager, "\tnode is primary");
 	_coll.AddPrimaryNode(ID);
+	_tree_heads.push_back(n);
       }
       // if node has a parent add it
-      if (_coll.GetNode(ID).hasParent()){
-	if (_verbose) { std::cout << "\tnode has parent" << std::endl; }
-	NodeID_t parent = _coll.GetNode(ID).getParent();
-	_coll.GetNode(parent).addChild(ID);
-	_coll.GetNode(ID).setParent(parent);
+      NodeID_t parent = -1;
+      Status_t parentStatus = node.tryGetParent(parent);
+      if (parentStatus == kMultipleParents)
+	throw ::geoalgo::GeoAlgoException(Form("MakeTree: Node %i has more than 1 parent! something went wrong!",(int)ID));
+      if (parentStatus == kSuccess){
+	GEOTREE_DEBUG(msg::kManager, "\tnode has parent");
+	_coll.EditNode(parent)->addChild(ID);
+	_coll.EditNode(ID)->setParent(parent);
+	_tree_parent[n] = _coll.FindIndex(parent);
       }
       // if node has a parent && a sibling
       // find vertex consistent with all 3 objects
-      if (_coll.GetNode(ID).hasConflict()){
-	if (_verbose) { std::cout << "\tnode has conflict" << std::endl; }
+      bool hasSiblings = (node.siblings().empty() == false);
+      if ( (parentStatus == kSuccess) and hasSiblings ){
+	GEOTREE_DEBUG(msg::kManager, "\tnode has conflict");
 	// The philosophy right now:
 	// Add particle as child of its parent.
 	// Do not worry about sibling relationship.
@@ -96,144 +393,666 @@ namespace geotree{
 	// if siblings & parent -> just add as child to parent
 	continue;
       }
-      // if node has sibling: make a common head node for the two siblings
-      if (_coll.GetNode(ID).hasSiblings()){
-	if (_verbose) { std::cout << "\tnode has sibling" << std::endl; }
-	if (_verbose) { std::cout << "\tadding node " << ID << " now" << std::endl; }
-	// get siblings
-	auto siblings = _coll.GetNode(ID).getSiblings();
-	if (_verbose) { std::cout << "\tnode has " << siblings.size() << " siblings" << std::endl;
-	}
-	// if > 1 siblings
-	// Make sure all siblings share the same vertex
-	if (siblings.size() > 1){
-	  auto const vtx = _coll.GetNode(ID).getVtx(siblings[0]);
-	  for (auto &s : siblings){
-	    auto const vtx2 = _coll.GetNode(ID).getVtx(s);
-	    if (vtx != vtx2)
+      // if node has sibling: make a common head node for its sibling group
+      if (hasSiblings){
+	GEOTREE_DEBUG(msg::kManager, "\tnode has sibling");
+	GEOTREE_DEBUG(msg::kManager, "\tadding node " << ID << " now");
+	auto const members = _siblings.GetMembers(n);
+	GEOTREE_DEBUG(msg::kManager, "\tnode has " << members.size()-1 << " siblings");
+	// Make sure all siblings in the group share the same vertex.
+	// The group takes that vertex and its highest sibling score
+	VertexID_t const vtx = node.siblings()[0].VtxID();
+	double score = 0.;
+	for (auto const& m : members){
+	  for (auto const& s : _coll.FindNode(IDs[m])->siblings()){
+	    if (_coll.Vertices().Same(vtx,s.VtxID()) == false)
 	      throw ::geoalgo::GeoAlgoException("Multiple siblings @ different Vertices. Should have been solved by SortSiblings!");
-	  }//for all siblings
-	}// if multiple siblings
-	// create new node to host the new siblings
-	NodeID_t id = ID*10+siblings[0]*100+1; 
-	// Make sure this ID does not exist
-	if (_coll.NodeExists(id) == true)
-	  throw ::geoalgo::GeoAlgoException(Form("About to create a NodeID that already exists (%i). Not acceptable!",(int)id));
-	_coll.AddNode(id);
-	// add child nodes to newly created node
-	_coll.GetNode(id).addChild(ID);
-	_coll.GetNode(ID).setParent(id);
-	// also add correlations so they show up on correlation matrix (not too important...)
-	AddCorrelation(id,ID,1.,::geoalgo::Point_t(3),::geotree::RelationType_t::kParent);
-	// loop over siblings and add them
-	for (auto& sib : siblings){ 
+	    if (s.Score() > score)
+	      score = s.Score();
+	  }
+	}// for all members of the group
+	_siblings.SetVertex(n,vtx);
+	_siblings.SetScore(n,score);
+	// create new node to host the siblings (new ID: cannot collide)
+	// (node references are not kept across AddNode: the node vector may grow)
+	NodeID_t const id = _coll.AddNode();
+	long const slot = _coll.NodeCount()-1;
+	_tree_parent.push_back(-1);
+	_stats.Count(ManagerStats::kSyntheticNode);
+	// add child nodes to newly created node: this one first,
+	// then the rest of the group in node order
+	_coll.EditNode(id)->addChild(ID);
+	_coll.EditNode(ID)->setParent(id);
+	_tree_parent[n] = slot;
+	// also add correlations so they show up on correlation matrix
+	// (all of them at the group's vertex)
+	TryAddCorrelationAt(id,ID,score,vtx,::geotree::RelationType_t::kParent);
+	for (auto const& m : members){
+	  NodeID_t const sib = IDs[m];
+	  if (sib == ID)
+	    continue;
 	  // add node parentage
-	  _coll.GetNode(id).addChild(sib);
-	  _coll.GetNode(sib).setParent(id);
-	AddCorrelation(id,sib,1.,::geoalgo::Point_t(3),::geotree::RelationType_t::kParent);
+	  _coll.EditNode(id)->addChild(sib);
+	  _coll.EditNode(sib)->setParent(id);
+	  _tree_parent[m] = slot;
+	  _tree_added[m] = true;
 	  // and correlations
+	  TryAddCorrelationAt(id,sib,score,vtx,::geotree::RelationType_t::kParent);
 	}
-	if (_verbose) { std::cout << "\tadding node " << id << " to tree nodes" << std::endl; }
+	GEOTREE_DEBUG(msg::kManager, "\tadding node " << id << " to tree nodes");
 	_coll.AddPrimaryNode(id);
-	if (_verbose){ 
-	  std::cout << "\tadded node " << id 
-		    << " as parent of: [" << ID << ", ";
-	  for (auto &sib : siblings)
-	    std::cout << sib << ", ";
-	  std::cout << std::endl;
+	_tree_heads.push_back(slot);
+	if (GEOTREE_LOG_ENABLED(msg::kManager,msg::kDEBUG)){
+	  LogLine line(msg::kManager,msg::kDEBUG);
+	  line.Stream() << "\tadded node " << id 
+			<< " as parent of: [";
+	  for (auto const& m : members)
+	    line.Stream() << IDs[m] << ", ";
 	}
       }// if node has a sbinling
     }// for all nodes
+
+    // flat copy of the forest, published for reader threads
+    _forest_event += 1;
+    _forest.Build(_coll,_tree_parent,_tree_heads,_forest_event,_forest_threads);
+    if ( _publish and (_published.Publish(_forest) == false) )
+      _stats.Count(ManagerStats::kForestNotPublished);
+
+    UpdatePeakMemory();
+    Logger::Flush();
     
   return;
   }
 
 
-  // Correlation provided indicates relationship between node id1 and node id2
-  void Manager::AddCorrelation(const NodeID_t id1, const NodeID_t id2,
-			       const double score,
-			       const geoalgo::Point_t& vtx,
-			       const geotree::RelationType_t type){
+  size_t Manager::BreakCycles(){
+
+    Logger::Scope log(_log_level);
+
+    ManagerStats::ScopedTimer timer(_stats,ManagerStats::kBreakCycles);
+
+    _broken_cycles.clear();
+
+    auto const& IDs = _coll.GetNodeIDs();
+    size_t const nodes = IDs.size();
+    size_t const none = std::numeric_limits<size_t>::max();
+
+    // a cycle needs parent correlations
+    bool parents = false;
+    for (size_t i=0; (i < nodes) and (parents == false); i++)
+      parents = (_coll.NodeAt(i).parents().empty() == false);
+    if (parents == false)
+      return 0;
+
+    // Tarjan on the graph child -> parent (same components as
+    // parent -> child, and the edges are read from parents()).
+    // Only active nodes are visited: all of them the first time,
+    // then the members of components in which an edge was removed.
+    // Scratch is kept by the manager (no allocation once warm)
+    std::vector<char>& active  = _cycles.active;
+    std::vector<char>& next    = _cycles.next;
+    std::vector<char>& onStack = _cycles.onStack;
+    std::vector<size_t>& index     = _cycles.index;
+    std::vector<size_t>& low       = _cycles.low;
+    std::vector<size_t>& component = _cycles.component;
+    std::vector<size_t>& stack     = _cycles.stack;
+    std::vector<size_t>& members   = _cycles.members;
+    // DFS frames: node and position in its list of parents
+    std::vector< std::pair<size_t,size_t> >& frames = _cycles.frames;
+    active.assign(nodes,1);
+    next.assign(nodes,0);
+    onStack.assign(nodes,0);
+    index.resize(nodes);
+    low.resize(nodes);
+    component.resize(nodes);
+    stack.clear();
+    frames.clear();
+
+    bool removed = true;
+    while (removed){
+
+      removed = false;
+      std::fill(index.begin(),index.end(),none);
+      std::fill(next.begin(),next.end(),0);
+      size_t counter = 0;
+
+      for (size_t root=0; root < nodes; root++){
+
+	if ( (active[root] == 0) or (index[root] != none) )
+	  continue;
+
+	index[root] = low[root] = counter++;
+	stack.push_back(root);
+	onStack[root] = 1;
+	frames.push_back(std::make_pair(root,(size_t)0));
+
+	while (frames.empty() == false){
+
+	  size_t const v = frames.back().first;
+	  auto const parents = _coll.FindNode(IDs[v])->parents();
+
+	  // next edge of v
+	  if (frames.back().second < parents.size()){
+	    size_t const w = _coll.FindIndex(parents[frames.back().second++].ID());
+	    if (active[w] == 0)
+	      continue;
+	    if (index[w] == none){
+	      index[w] = low[w] = counter++;
+	      stack.push_back(w);
+	      onStack[w] = 1;
+	      frames.push_back(std::make_pair(w,(size_t)0));
+	    }
+	    else if (onStack[w] == 1)
+	      low[v] = std::min(low[v],index[w]);
+	    continue;
+	  }
 
-    // make sure nodes exist
-    if (_coll.NodeExists(id1) == false)
-      throw ::geoalgo::GeoAlgoException("Node ID not found!");
-    if (_coll.NodeExists(id2) == false)
-      throw ::geoalgo::GeoAlgoException("Node ID not found!");
+	  // v is done
+	  frames.pop_back();
+	  if (frames.empty() == false){
+	    size_t const u = frames.back().first;
+	    low[u] = std::min(low[u],low[v]);
+	  }
+	  if (low[v] != index[v])
+	    continue;
+
+	  // v is the root of a component
+	  members.clear();
+	  size_t w;
+	  do {
+	    w = stack.back();
+	    stack.pop_back();
+	    onStack[w] = 0;
+	    component[w] = v;
+	    members.push_back(w);
+	  } while (w != v);
+	  if (members.size() < 2)
+	    continue;
+
+	  // lowest-score parent-child correlation inside the component
+	  CycleEdge_t cut;
+	  cut.score = std::numeric_limits<double>::max();
+	  cut.cycleSize = members.size();
+	  bool found = false;
+	  for (auto const& m : members){
+	    for (auto const& c : _coll.FindNode(IDs[m])->parents()){
+	      if (component[_coll.FindIndex(c.ID())] != v)
+		continue;
+	      bool const better = ( (found == false) or (c.Score() < cut.score) or
+				    ( (c.Score() == cut.score) and
+				      (std::make_pair(c.ID(),IDs[m]) < std::make_pair(cut.parent,cut.child)) ) );
+	      if (better){
+		found = true;
+		cut.parent = c.ID();
+		cut.child  = IDs[m];
+		cut.score  = c.Score();
+	      }
+	    }
+	  }
+
+	  GEOTREE_WARNING(msg::kManager, "BreakCycles: " << members.size() << " nodes form a cycle of parents."
+			  << " Removing correlation " << cut.parent << " parent of " << cut.child
+			  << " (score " << cut.score << ")");
+	  TryEraseCorrelation(cut.parent,cut.child);
+	  _stats.Count(ManagerStats::kCycleEdgeRemoved);
+	  _broken_cycles.push_back(cut);
+
+	  // the rest of the component may still hold a cycle
+	  for (auto const& m : members)
+	    next[m] = 1;
+	  removed = true;
+
+	}// DFS from root
+      }// for all roots
+
+      active.swap(next);
+    }// until no cycle is left
+
+    return _broken_cycles.size();
+  }
+
+
+  size_t Manager::LoadArrays(size_t nnodes, const long* nodes,
+			     size_t n, const long* id1, const long* id2,
+			     const double* score, const double* vtx, const int* type){
+
+    Logger::Scope log(_log_level);
+
+    Reset();
+
+    std::vector<NodeID_t> IDs;
+    if (nodes != nullptr){
+      IDs.reserve(nnodes);
+      for (size_t i=0; i < nnodes; i++){
+	if (nodes[i] < 0)
+	  throw ::geoalgo::GeoAlgoException(Form("LoadArrays: negative node ID in row %i",(int)i));
+	IDs.push_back(nodes[i]);
+      }
+    }
+    else{
+      // one node per distinct ID, in increasing ID order
+      IDs.reserve(2*n);
+      for (size_t i=0; i < n; i++){
+	if ( (id1[i] < 0) or (id2[i] < 0) )
+	  throw ::geoalgo::GeoAlgoException(Form("LoadArrays: negative node ID in row %i",(int)i));
+	IDs.push_back(id1[i]);
+	IDs.push_back(id2[i]);
+      }
+      std::sort(IDs.begin(),IDs.end());
+      IDs.erase(std::unique(IDs.begin(),IDs.end()),IDs.end());
+    }
+
+    Reserve(IDs.size(),n);
+    for (auto const& ID : IDs)
+      _coll.AddNode(ID);
+
+    ::geoalgo::Point_t pt(3);
+    for (size_t i=0; i < n; i++){
+      if ( (type[i] < ::geotree::RelationType_t::kParent) or (type[i] > ::geotree::RelationType_t::kUnknown) )
+	throw ::geoalgo::GeoAlgoException(Form("LoadArrays: invalid relation type %i in row %i",type[i],(int)i));
+      pt[0] = vtx[3*i];
+      pt[1] = vtx[3*i+1];
+      pt[2] = vtx[3*i+2];
+      AddCorrelation(id1[i],id2[i],score[i],pt,(::geotree::RelationType_t)type[i]);
+    }
+
+    return IDs.size();
+  }
+
+
+  size_t Manager::FillForestArrays(size_t capacity, long* id, long* parent,
+				   int* depth, double* vtx) const {
+
+    size_t const nodes = _forest.Size();
+
+    if (capacity < nodes)
+      throw ::geoalgo::GeoAlgoException(Form("FillForestArrays: room for %i nodes, %i needed",(int)capacity,(int)nodes));
+
+    for (size_t i=0; i < nodes; i++){
+      id[i]     = _forest.ID(i);
+      parent[i] = _forest.Parent(i);
+      depth[i]  = _forest.Depth(i);
+      for (size_t k=0; k < 3; k++)
+	vtx[3*i+k] = _forest.Vertex(i)[k];
+    }
+
+    return nodes;
+  }
+
+
+  size_t Manager::ResolveBatch(size_t nev, const long* nodeInOffsets, const long* nodeIn,
+			       const long* offsets, const long* id1, const long* id2,
+			       const double* score, const double* vtx, const int* type,
+			       size_t capacity, long* id, long* parent,
+			       int* depth, double* vtxOut, long* nodeOffsets, int* ok){
+
+    Logger::Scope log(_log_level);
+
+    size_t rows = 0;
+    nodeOffsets[0] = 0;
+
+    for (size_t e=0; e < nev; e++){
+
+      if ( (offsets[e] < 0) or (offsets[e+1] < offsets[e]) )
+	throw ::geoalgo::GeoAlgoException(Form("ResolveBatch: invalid offsets for event %i",(int)e));
+      size_t const first = offsets[e];
+      size_t const n     = offsets[e+1] - offsets[e];
+      const long* nodes = nullptr;
+      size_t nnodes = 0;
+      if ( (nodeIn != nullptr) and (nodeInOffsets != nullptr) ){
+	if ( (nodeInOffsets[e] < 0) or (nodeInOffsets[e+1] < nodeInOffsets[e]) )
+	  throw ::geoalgo::GeoAlgoException(Form("ResolveBatch: invalid node offsets for event %i",(int)e));
+	nodes  = nodeIn + nodeInOffsets[e];
+	nnodes = nodeInOffsets[e+1] - nodeInOffsets[e];
+      }
+
+      // a bad event is flagged, not fatal for the batch
+      bool resolved = false;
+      try{
+	LoadArrays(nnodes,nodes,n,id1+first,id2+first,score+first,vtx+3*first,type+first);
+	ResolveConflicts();
+	MakeTree();
+	resolved = true;
+      }
+      catch (std::exception& ex){
+	GEOTREE_WARNING(msg::kManager, "ResolveBatch: event " << e << " failed: " << ex.what());
+      }
+
+      ok[e] = 0;
+      if (resolved){
+	if (NodeCount() > capacity - rows)
+	  throw ::geoalgo::GeoAlgoException(Form("ResolveBatch: output arrays full at event %i",(int)e));
+	rows += FillForestArrays(capacity-rows,id+rows,parent+rows,depth+rows,vtxOut+3*rows);
+	ok[e] = 1;
+      }
+      nodeOffsets[e+1] = rows;
+    }
+
+    return rows;
+  }
+
+
+  // inverse of a relation: relation of id1 w.r.t. id2 given that of id2 w.r.t. id1
+  geotree::RelationType_t Manager::InverseRelation(const geotree::RelationType_t type){
 
-    //type returned is the relation of 1 w.r.t. 2
-    // find "inverse" relation to assign to 2 w.r.t. 1
-    geotree::RelationType_t otherRel = geotree::RelationType_t::kUnknown;
     if (type == geotree::RelationType_t::kSibling)
-      otherRel = geotree::RelationType_t::kSibling;
+      return geotree::RelationType_t::kSibling;
     else if (type == geotree::RelationType_t::kChild)
-      otherRel = geotree::RelationType_t::kParent;
+      return geotree::RelationType_t::kParent;
     else if (type == geotree::RelationType_t::kParent)
-      otherRel = geotree::RelationType_t::kChild;
+      return geotree::RelationType_t::kChild;
 
-    // make sure this relation is not prohibited
-    if ( _coll.GetNode(id1).isProhibited(otherRel) ||
-	 _coll.GetNode(id2).isProhibited(type) ){
-      if (_verbose) { std::cout << "\tCorrelation is Prohibited!" << std::endl; }
+    return geotree::RelationType_t::kUnknown;
+  }
+
+
+  // turn a status from the non-throwing API in an exception
+  void Manager::ThrowOnError(const Status_t status){
+
+    // prohibited correlations are silently ignored
+    if ( (status == kSuccess) or (status == kProhibited) )
       return;
+
+    throw ::geoalgo::GeoAlgoException(StatusMessage(status));
+  }
+
+
+  Status_t Manager::CheckAdd(const NodeID_t id1, const NodeID_t id2,
+			     const geotree::RelationType_t type) const {
+
+    // make sure nodes exist
+    const Node* node1 = _coll.FindNode(id1);
+    const Node* node2 = _coll.FindNode(id2);
+    if ( (node1 == nullptr) or (node2 == nullptr) )
+      return kNodeNotFound;
+
+    // make sure this relation is not prohibited
+    if ( node1->isProhibited(InverseRelation(type)) ||
+	 node2->isProhibited(type) ){
+      GEOTREE_DEBUG(msg::kManager, "\tCorrelation is Prohibited!");
+      return kProhibited;
     }
 
-    if (_verbose) { std::cout << "\tAdding Correlation..." << std::endl; }
-    _coll.GetNode(id2).addCorrelation(id1,score,vtx,type);    
-    _coll.GetNode(id1).addCorrelation(id2,score,vtx,otherRel);
+    // check both ends before touching either
+    if ( node1->isCorrelated(id2) or node2->isCorrelated(id1) )
+      return kCorrelationExists;
 
-    return;
+    return kSuccess;
   }
 
 
-  void Manager::EditCorrelation(const NodeID_t id1, const NodeID_t id2,
-				const double score,
-				const geoalgo::Point_t& vtx,
-				const geotree::RelationType_t type){
+  Status_t Manager::CheckEdit(const NodeID_t id1, const NodeID_t id2,
+			      const geotree::RelationType_t type) const {
 
     // make sure nodes exist
-    if (_coll.NodeExists(id1) == false)
-      throw ::geoalgo::GeoAlgoException("Node ID not found!");
-    if (_coll.NodeExists(id2) == false)
-      throw ::geoalgo::GeoAlgoException("Node ID not found!");
+    const Node* node1 = _coll.FindNode(id1);
+    const Node* node2 = _coll.FindNode(id2);
+    if ( (node1 == nullptr) or (node2 == nullptr) )
+      return kNodeNotFound;
+
+    // make sure this relation is not prohibited
+    if ( node1->isProhibited(InverseRelation(type)) ||
+	 node2->isProhibited(type) ){
+      GEOTREE_DEBUG(msg::kManager, "\tCorrelation is Prohibited!");
+      return kProhibited;
+    }
+
+    if ( (node1->isCorrelated(id2) == false) or (node2->isCorrelated(id1) == false) )
+      return kCorrelationNotFound;
+
+    return kSuccess;
+  }
+
+
+  // Correlation provided indicates relationship between node id1 and node id2
+  Status_t Manager::TryAddCorrelation(const NodeID_t id1, const NodeID_t id2,
+				      const double score,
+				      const geoalgo::Point_t& vtx,
+				      const geotree::RelationType_t type) {
+
+    Logger::Scope log(_log_level);
+
+    // check first: a failed add must not create a vertex
+    Status_t const status = CheckAdd(id1,id2,type);
+    if (status != kSuccess)
+      return status;
+
+    return AddCorrelationOwn(id1,id2,score,_coll.EditVertices().Add(vtx),type);
+  }
+
+
+  Status_t Manager::TryAddCorrelationAt(const NodeID_t id1, const NodeID_t id2,
+					const double score,
+					const VertexID_t vtx,
+					const geotree::RelationType_t type) {
+
+    Logger::Scope log(_log_level);
+
+    Status_t const status = CheckAdd(id1,id2,type);
+    if (status != kSuccess)
+      return status;
+
+    return AddCorrelationOwn(id1,id2,score,_coll.EditVertices().Alias(vtx),type);
+  }
+
+
+  Status_t Manager::AddCorrelationOwn(const NodeID_t id1, const NodeID_t id2,
+				      const double score,
+				      const VertexID_t vtx,
+				      const geotree::RelationType_t type) {
 
     //type returned is the relation of 1 w.r.t. 2
     // find "inverse" relation to assign to 2 w.r.t. 1
-    geotree::RelationType_t otherRel = geotree::RelationType_t::kUnknown;
-    if (type == geotree::RelationType_t::kSibling)
-      otherRel = geotree::RelationType_t::kSibling;
-    else if (type == geotree::RelationType_t::kChild)
-      otherRel = geotree::RelationType_t::kParent;
-    else if (type == geotree::RelationType_t::kParent)
-      otherRel = geotree::RelationType_t::kChild;
+    geotree::RelationType_t otherRel = InverseRelation(type);
+
+    GEOTREE_DEBUG(msg::kManager, "\tAdding Correlation...");
+
+    SaveUndo(id1,id2,_coll.FindNode(id1),_coll.FindNode(id2));
+    _coll.EditNode(id2)->tryAddCorrelation(id1,score,vtx,type);
+    _coll.EditNode(id1)->tryAddCorrelation(id2,score,vtx,otherRel);
+    Touched(id1,id2);
+    _stats.Count(ManagerStats::kCorrelationAdded);
+
+    return kSuccess;
+  }
+
+
+  Status_t Manager::TryEditCorrelation(const NodeID_t id1, const NodeID_t id2,
+				       const double score,
+				       const geoalgo::Point_t& vtx,
+				       const geotree::RelationType_t type) {
+
+    Logger::Scope log(_log_level);
+
+    // the correlation gets a vertex of its own:
+    // others that shared its old vertex keep it
+    Status_t const status = CheckEdit(id1,id2,type);
+    if (status != kSuccess)
+      return status;
+
+    return EditCorrelationOwn(id1,id2,score,_coll.EditVertices().Add(vtx),type);
+  }
+
+
+  Status_t Manager::TryEditCorrelationAt(const NodeID_t id1, const NodeID_t id2,
+					 const double score,
+					 const VertexID_t vtx,
+					 const geotree::RelationType_t type) {
+
+    Logger::Scope log(_log_level);
+
+    Status_t const status = CheckEdit(id1,id2,type);
+    if (status != kSuccess)
+      return status;
+
+    return EditCorrelationOwn(id1,id2,score,_coll.EditVertices().Alias(vtx),type);
+  }
+
+
+  Status_t Manager::EditCorrelationOwn(const NodeID_t id1, const NodeID_t id2,
+				       const double score,
+				       const VertexID_t vtx,
+				       const geotree::RelationType_t type) {
+
+    //type returned is the relation of 1 w.r.t. 2
+    // find "inverse" relation to assign to 2 w.r.t. 1
+    geotree::RelationType_t otherRel = InverseRelation(type);
+
+    GEOTREE_DEBUG(msg::kManager, "\tEditing Correlation...");
+
+    SaveUndo(id1,id2,_coll.FindNode(id1),_coll.FindNode(id2));
+    _coll.EditNode(id2)->tryEditCorrelation(id1,score,vtx,type);
+    _coll.EditNode(id1)->tryEditCorrelation(id2,score,vtx,otherRel);
+    Touched(id1,id2);
+    _stats.Count(ManagerStats::kCorrelationEdited);
+
+    return kSuccess;
+  }
+
+
+  Status_t Manager::TryEditCorrelation(const NodeID_t id1, const NodeID_t id2,
+				       const double score) {
+
+    Logger::Scope log(_log_level);
+
+    // make sure nodes exist
+    const Node* node1 = _coll.FindNode(id1);
+    const Node* node2 = _coll.FindNode(id2);
+    if ( (node1 == nullptr) or (node2 == nullptr) )
+      return kNodeNotFound;
+
+    if ( (node1->isCorrelated(id2) == false) or (node2->isCorrelated(id1) == false) )
+      return kCorrelationNotFound;
+
+    GEOTREE_DEBUG(msg::kManager, "\tEditing Correlation Score...");
+
+    SaveUndo(id1,id2,node1,node2);
+    _coll.EditNode(id2)->tryEditCorrelation(id1,score);
+    _coll.EditNode(id1)->tryEditCorrelation(id2,score);
+    Touched(id1,id2);
+    _stats.Count(ManagerStats::kCorrelationEdited);
+
+    return kSuccess;
+  }
+
+
+  Status_t Manager::TryEditCorrelation(const NodeID_t id1, const NodeID_t id2,
+				       const geoalgo::Point_t& vtx) {
+
+    Logger::Scope log(_log_level);
+
+    // make sure nodes exist
+    const Node* node1 = _coll.FindNode(id1);
+    const Node* node2 = _coll.FindNode(id2);
+    if ( (node1 == nullptr) or (node2 == nullptr) )
+      return kNodeNotFound;
+
+    if ( (node1->isCorrelated(id2) == false) or (node2->isCorrelated(id1) == false) )
+      return kCorrelationNotFound;
+
+    GEOTREE_DEBUG(msg::kManager, "\tEditing Correlation Vtx...");
+
+    // new vertex for this correlation only
+    VertexID_t const id = _coll.EditVertices().Add(vtx);
+    SaveUndo(id1,id2,node1,node2);
+    _coll.EditNode(id2)->tryEditVertex(id1,id);
+    _coll.EditNode(id1)->tryEditVertex(id2,id);
+    Touched(id1,id2);
+    _stats.Count(ManagerStats::kCorrelationEdited);
+
+    return kSuccess;
+  }
+
+
+  Status_t Manager::TryEditCorrelation(const NodeID_t id1, const NodeID_t id2,
+				       const geotree::RelationType_t type) {
+
+    Logger::Scope log(_log_level);
+
+    // make sure nodes exist
+    const Node* node1 = _coll.FindNode(id1);
+    const Node* node2 = _coll.FindNode(id2);
+    if ( (node1 == nullptr) or (node2 == nullptr) )
+      return kNodeNotFound;
+
+    //type returned is the relation of 1 w.r.t. 2
+    // find "inverse" relation to assign to 2 w.r.t. 1
+    geotree::RelationType_t otherRel = InverseRelation(type);
 
     // make sure this relation is not prohibited
-    if ( _coll.GetNode(id1).isProhibited(otherRel) ||
-	 _coll.GetNode(id2).isProhibited(type) ){
-      if (_verbose) { std::cout << "\tCorrelation is Prohibited!" << std::endl; }
-      return;
+    if ( node1->isProhibited(otherRel) ||
+	 node2->isProhibited(type) ){
+      GEOTREE_DEBUG(msg::kManager, "\tCorrelation is Prohibited!");
+      return kProhibited;
     }
 
-    if (_verbose) { std::cout << "\tEditing Correlation..." << std::endl; }
-    _coll.GetNode(id2).editCorrelation(id1,score,vtx,type);    
-    _coll.GetNode(id1).editCorrelation(id2,score,vtx,otherRel);
+    if ( (node1->isCorrelated(id2) == false) or (node2->isCorrelated(id1) == false) )
+      return kCorrelationNotFound;
+
+    GEOTREE_DEBUG(msg::kManager, "\tEditing Correlation Relation...");
+
+    SaveUndo(id1,id2,node1,node2);
+    _coll.EditNode(id2)->tryEditCorrelation(id1,type);
+    _coll.EditNode(id1)->tryEditCorrelation(id2,otherRel);
+    Touched(id1,id2);
+    _stats.Count(ManagerStats::kCorrelationEdited);
+
+    return kSuccess;
+  }
+
+
+  /// Erase a correlation completely
+  Status_t Manager::TryEraseCorrelation(const NodeID_t id1, const NodeID_t id2) {
+
+    Logger::Scope log(_log_level);
+
+    // make sure nodes exist
+    const Node* node1 = _coll.FindNode(id1);
+    const Node* node2 = _coll.FindNode(id2);
+    if ( (node1 == nullptr) or (node2 == nullptr) )
+      return kNodeNotFound;
+
+    if ( (node1->isCorrelated(id2) == false) and (node2->isCorrelated(id1) == false) )
+      return kCorrelationNotFound;
+
+    GEOTREE_DEBUG(msg::kManager, "\tRemoving Correlation...");
+
+    SaveUndo(id1,id2,node1,node2);
+    _coll.EditNode(id1)->eraseCorrelation(id2);
+    _coll.EditNode(id2)->eraseCorrelation(id1);
+    Touched(id1,id2);
+    _stats.Count(ManagerStats::kCorrelationErased);
+
+    return kSuccess;
+  }
+
+
+  void Manager::AddCorrelation(const NodeID_t id1, const NodeID_t id2,
+			       const double score,
+			       const geoalgo::Point_t& vtx,
+			       const geotree::RelationType_t type){
+
+    ThrowOnError(TryAddCorrelation(id1,id2,score,vtx,type));
 
     return;
   }
 
 
   void Manager::EditCorrelation(const NodeID_t id1, const NodeID_t id2,
-				const double score){
+				const double score,
+				const geoalgo::Point_t& vtx,
+				const geotree::RelationType_t type){
 
-    // make sure nodes exist
-    if (_coll.NodeExists(id1) == false)
-      throw ::geoalgo::GeoAlgoException("Node ID not found!");
-    if (_coll.NodeExists(id2) == false)
-      throw ::geoalgo::GeoAlgoException("Node ID not found!");
+    ThrowOnError(TryEditCorrelation(id1,id2,score,vtx,type));
+
+    return;
+  }
 
-    if (_verbose) { std::cout << "\tEditing Correlation Score..." << std::endl; }
-    _coll.GetNode(id2).editCorrelation(id1,score);
-    _coll.GetNode(id1).editCorrelation(id2,score);
+
+  void Manager::EditCorrelation(const NodeID_t id1, const NodeID_t id2,
+				const double score){
+
+    ThrowOnError(TryEditCorrelation(id1,id2,score));
 
     return;
   }
@@ -242,15 +1061,7 @@ namespace geotree{
   void Manager::EditCorrelation(const NodeID_t id1, const NodeID_t id2,
 				const geoalgo::Point_t& vtx){
 
-    // make sure nodes exist
-    if (_coll.NodeExists(id1) == false)
-      throw ::geoalgo::GeoAlgoException("Node ID not found!");
-    if (_coll.NodeExists(id2) == false)
-      throw ::geoalgo::GeoAlgoException("Node ID not found!");
-
-    if (_verbose) { std::cout << "\tEditing Correlation Vtx..." << std::endl; }
-    _coll.GetNode(id2).editCorrelation(id1,vtx);
-    _coll.GetNode(id1).editCorrelation(id2,vtx);
+    ThrowOnError(TryEditCorrelation(id1,id2,vtx));
 
     return;
   }
@@ -259,73 +1070,203 @@ namespace geotree{
   void Manager::EditCorrelation(const NodeID_t id1, const NodeID_t id2,
 				const geotree::RelationType_t type){
 
-    // make sure nodes exist
-    if (_coll.NodeExists(id1) == false)
-      throw ::geoalgo::GeoAlgoException("Node ID not found!");
-    if (_coll.NodeExists(id2) == false)
-      throw ::geoalgo::GeoAlgoException("Node ID not found!");
+    ThrowOnError(TryEditCorrelation(id1,id2,type));
 
-    //type returned is the relation of 1 w.r.t. 2
-    // find "inverse" relation to assign to 2 w.r.t. 1
-    geotree::RelationType_t otherRel = geotree::RelationType_t::kUnknown;
-    if (type == geotree::RelationType_t::kSibling)
-      otherRel = geotree::RelationType_t::kSibling;
-    else if (type == geotree::RelationType_t::kChild)
-      otherRel = geotree::RelationType_t::kParent;
-    else if (type == geotree::RelationType_t::kParent)
-      otherRel = geotree::RelationType_t::kChild;
+    return;
+  }
 
-    // make sure this relation is not prohibited
-    if ( _coll.GetNode(id1).isProhibited(otherRel) ||
-	 _coll.GetNode(id2).isProhibited(type) ){
-      if (_verbose) { std::cout << "\tCorrelation is Prohibited!" << std::endl; }
-      return;
+
+  /// Erase a correlation completely (no error if the nodes are not correlated)
+  void Manager::EraseCorrelation(const NodeID_t id1, const NodeID_t id2){
+
+    Status_t status = TryEraseCorrelation(id1,id2);
+    if (status != kCorrelationNotFound)
+      ThrowOnError(status);
+
+    return;
+  }
+
+  void Manager::ResolveConflicts(){
+
+    Logger::Scope log(_log_level);
+
+    ManagerStats::ScopedTimer timer(_stats,ManagerStats::kResolveConflicts);
+
+    InvalidateLazy();
+
+    // remove weak correlations before looking at conflicts
+    if (_prune.Enabled()){
+      GEOTREE_DEBUG(msg::kManager, "Prune correlations...");
+      Prune();
+    }
+
+    // one pass over the nodes: candidates of each stage.
+    // Stages only visit their candidates and are skipped if
+    // there are none (an event without conflicts skips them all).
+    // Without census every stage visits every node
+    if (_conflict_census){
+      _census.Take(_coll);
+      GEOTREE_DEBUG(msg::kManager, "Census: " << _census.Count(ConflictCensus::kMultipleParents) << " multiple parents, "
+		    << _census.Count(ConflictCensus::kParentSibling) << " parent + sibling, "
+		    << _census.Count(ConflictCensus::kMultipleSiblings) << " multiple siblings");
+      if (_census.Trivial())
+	_stats.Count(ManagerStats::kTrivialEvent);
+    }
+    else
+      _census.Clear();
+
+    try{
+
+      // first resolve conflict 1)
+      // if multiple parents, choose the
+      // one with the highest score
+      GEOTREE_DEBUG(msg::kManager, "Find Best parent of nodes if they have multiple ones...");
+      if (StageNeeded(ConflictCensus::kMultipleParents))
+	FindBestParent();
+      else
+	_stats.Count(ManagerStats::kConflictStageSkipped);
+
+      // Case in which parent and sibling are siblings
+      GEOTREE_DEBUG(msg::kManager, "Make sure parent and sibling are logically consistent if they exist");
+      if (StageNeeded(ConflictCensus::kParentSibling))
+	ParentIsSiblingsSibling();
+      else
+	_stats.Count(ManagerStats::kConflictStageSkipped);
+
+      // if there is a conflict, remove sibling relation
+      GEOTREE_DEBUG(msg::kManager, "If there is a conflict, remove sibling status");
+      if (StageNeeded(ConflictCensus::kParentSibling))
+	GenericConflict();
+      else
+	_stats.Count(ManagerStats::kConflictStageSkipped);
+
+      // Conflict 3)
+      // Resolve conflict of multiple siblings
+      GEOTREE_DEBUG(msg::kManager, "merge or find best sibling if there are multiple siblings...");
+      if (StageNeeded(ConflictCensus::kMultipleSiblings))
+	SortSiblings();
+      else
+	_stats.Count(ManagerStats::kConflictStageSkipped);
+
+    }
+    catch (...){
+      _census.Done();
+      throw;
     }
 
-    if (_verbose) { std::cout << "\tEditing Correlation Relation..." << std::endl; }
-    _coll.GetNode(id2).editCorrelation(id1,type);
-    _coll.GetNode(id1).editCorrelation(id2,otherRel);
+    _census.Done();
+    UpdatePeakMemory();
+    Logger::Flush();
 
     return;
   }
 
 
-  /// Erase a correlation completely
-  void Manager::EraseCorrelation(const NodeID_t id1, const NodeID_t id2){
+  void Manager::Prune(){
 
-    // make sure nodes exist
-    if (_coll.NodeExists(id1) == false)
-      throw ::geoalgo::GeoAlgoException("Node ID not found!");
-    if (_coll.NodeExists(id2) == false)
-      throw ::geoalgo::GeoAlgoException("Node ID not found!");
+    Logger::Scope log(_log_level);
 
-    if (_verbose) { std::cout << "\tRemoving Correlation..." << std::endl; }
-    _coll.GetNode(id1).eraseCorrelation(id2);
-    _coll.GetNode(id2).eraseCorrelation(id1);
+    ManagerStats::ScopedTimer timer(_stats,ManagerStats::kPrune);
+
+    InvalidateLazy();
+
+    // (node, other) pairs to remove
+    std::vector< std::pair<NodeID_t,NodeID_t> > drops;
+    std::vector< std::pair<double,NodeID_t> > parents, siblings;
+
+    auto const& IDs = _coll.GetNodeIDs();
+
+    // decide: each node looks at its parents and siblings
+    for (auto const& ID : IDs){
+      parents.clear();
+      siblings.clear();
+      const Node* node = _coll.FindNode(ID);
+      for (auto const& c : node->parents())
+	parents.push_back(std::make_pair(c.Score(),c.ID()));
+      for (auto const& c : node->siblings())
+	siblings.push_back(std::make_pair(c.Score(),c.ID()));
+      PruneCandidates(ID,parents,_prune.parentFloor,_prune.dropDominated,_prune.maxParents,drops);
+      PruneCandidates(ID,siblings,_prune.siblingFloor,false,_prune.maxSiblings,drops);
+    }
+
+    if (drops.empty())
+      return;
+
+    // both directions, grouped by node
+    size_t const n = drops.size();
+    for (size_t i=0; i < n; i++)
+      drops.push_back(std::make_pair(drops[i].second,drops[i].first));
+    std::sort(drops.begin(),drops.end());
+    drops.erase(std::unique(drops.begin(),drops.end()),drops.end());
+
+    size_t pairs = 0;
+    for (auto const& d : drops){
+      if (d.first > d.second) continue;
+      pairs += 1;
+      SaveUndo(d.first,d.second,_coll.FindNode(d.first),_coll.FindNode(d.second));
+    }
+
+    // apply: one pass over the correlations of each affected node
+    for (size_t i=0; i < drops.size(); ){
+      size_t j = i;
+      while ( (j < drops.size()) and (drops[j].first == drops[i].first) )
+	j++;
+      auto const begin = drops.begin()+i;
+      auto const end   = drops.begin()+j;
+      NodeID_t const ID = drops[i].first;
+      _coll.EditNode(ID)->eraseCorrelationsIf([&](NodeID_t other, const CorrelationEntry&)
+					      { return std::binary_search(begin,end,std::make_pair(ID,other)); });
+      i = j;
+    }
+
+    GEOTREE_DEBUG(msg::kManager, "\tpruned " << pairs << " correlations");
+    _stats.Count(ManagerStats::kCorrelationPruned,pairs);
 
     return;
   }
 
-  void Manager::ResolveConflicts(){
 
-    // first resolve conflict 1)
-    // if multiple parents, choose the
-    // one with the highest score
-    if (_verbose) { std::cout << "Find Best parent of nodes if they have multiple ones..." << std::endl; }
-    FindBestParent();
+  void Manager::PruneCandidates(const NodeID_t ID,
+				std::vector< std::pair<double,NodeID_t> >& cand,
+				const double floor, const bool dominated, const size_t maxKeep,
+				std::vector< std::pair<NodeID_t,NodeID_t> >& drops){
 
-    // Case in which parent and sibling are siblings
-    if (_verbose) { std::cout << "Make sure parent and sibling are logically consistent if they exist" << std::endl; }
-    ParentIsSiblingsSibling();
+    if (cand.empty())
+      return;
 
-    // if there is a conflict, remove sibling relation
-    if (_verbose) { std::cout << "If there is a conflict, remove sibling status" << std::endl; }
-    GenericConflict();
+    // score floor
+    size_t kept = 0;
+    for (size_t i=0; i < cand.size(); i++){
+      if (cand[i].first < floor)
+	drops.push_back(std::make_pair(ID,cand[i].second));
+      else
+	cand[kept++] = cand[i];
+    }
+    cand.resize(kept);
+
+    // same rule as FindBestParent + AlgoMultipleParentsHighScore:
+    // with 2 or more parents keep the first one with the highest score > 0
+    if ( dominated and (cand.size() > 1) ){
+      double highScore = 0;
+      NodeID_t best = -1;
+      for (auto const& c : cand){
+	if (c.first > highScore){
+	  highScore = c.first;
+	  best = c.second;
+	}
+      }
+      for (auto const& c : cand)
+	if (c.second != best) drops.push_back(std::make_pair(ID,c.second));
+      return;
+    }
 
-    // Conflict 3)
-    // Resolve conflict of multiple siblings
-    if (_verbose) { std::cout << "merge or find best sibling if there are multiple siblings..." << std::endl; }
-    SortSiblings();
+    // top-K: highest score, lowest ID on ties
+    if ( (maxKeep > 0) and (cand.size() > maxKeep) ){
+      std::stable_sort(cand.begin(),cand.end(),
+		       [](const std::pair<double,NodeID_t>& a, const std::pair<double,NodeID_t>& b) { return a.first > b.first; });
+      for (size_t i=maxKeep; i < cand.size(); i++)
+	drops.push_back(std::make_pair(ID,cand[i].second));
+    }
 
     return;
   }
@@ -334,11 +1275,13 @@ namespace geotree{
   /// Find best parent for each Node
   void Manager::FindBestParent(){
 
-    // Get list of nodes
-    auto const IDs = _coll.GetNodeIDs();
+    ManagerStats::ScopedTimer timer(_stats,ManagerStats::kFindBestParent);
 
-    for (auto &ID : IDs)
-      FindBestParent(ID);
+    // candidates only when called by ResolveConflicts
+    auto const& IDs = _coll.GetNodeIDs();
+    for (size_t i=Candidate(ConflictCensus::kMultipleParents,0); i < IDs.size();
+	 i=Candidate(ConflictCensus::kMultipleParents,i+1))
+      FindBestParent(IDs[i]);
 
     return;
   }
@@ -346,26 +1289,15 @@ namespace geotree{
   /// function to find best parent of a node (remove other parents)
   void Manager::FindBestParent(NodeID_t ID){
 
-    if (_verbose) { std::cout << "look for best parent for node: " << ID << std::endl; }
+    GEOTREE_DEBUG(msg::kManager, "look for best parent for node: " << ID);
 
-    // iterator for correlation types
-    std::map<NodeID_t,geotree::Correlation>::const_iterator it;
-    // get correaltions for this node
-    auto const corrs  = _coll.GetNode(ID).getCorrelations();
+    const Node* node = _coll.FindNode(ID);
+    if (node == nullptr)
+      return;
 
     // vector where to hold parent IDs
-    std::vector<NodeID_t> parentIDs;
-    // vector where to hold parent scores
-    std::vector<double> parentScores;
-
-    for (it = corrs.begin(); it != corrs.end(); it++){
-      if ((it->second).Relation() == geotree::RelationType_t::kParent){
-	//if (it->second == geotree::RelationType_t::kChild){
-	size_t pID = it->first;
-	parentIDs.push_back(pID);
-	parentScores.push_back(_coll.GetNode(ID).getScore(pID));
-      }
-    }
+    IDList_t parentIDs;
+    node->getParents(parentIDs);
 
     // if < 1 parent -> continue
     if (parentIDs.size() < 2)
@@ -373,8 +1305,9 @@ namespace geotree{
 
     // Ok, let's give the algorithm a shot! 
     // call the algorithm with node & vector of parent nodes
-    if (_verbose) { std::cout << "\talgoMultipleParents called..." << std::endl; }
+    GEOTREE_DEBUG(msg::kManager, "\talgoMultipleParents called...");
     _algoMultipleParents->FindBestParent(ID,parentIDs);
+    _stats.Count(ManagerStats::kAlgoMultipleParents);
 
 
     // now loop through correlations found and act on them
@@ -386,42 +1319,96 @@ namespace geotree{
   // Sort all siblings at once
   void Manager::SortSiblings(){
 
-    // Get list of nodes
-    auto const IDs = _coll.GetNodeIDs();
+    Logger::Scope log(_log_level);
+
+    ManagerStats::ScopedTimer timer(_stats,ManagerStats::kSortSiblings);
+
+    if ( (_loose == false) and _sibling_matching ){
+      MatchSiblings();
+      return;
+    }
+
+    auto const& IDs = _coll.GetNodeIDs();
+
+    // loose mode: keep track of the sibling groups merged so far,
+    // so that each group is brought to its final state only once
+    SiblingGroups* groups = nullptr;
+    if (_loose){
+      _siblings.Reset(IDs.size());
+      groups = &_siblings;
+    }
 
-    for (auto &ID : IDs)
-      SortSiblings(ID);
+    for (size_t i=Candidate(ConflictCensus::kMultipleSiblings,0); i < IDs.size();
+	 i=Candidate(ConflictCensus::kMultipleSiblings,i+1))
+      SortSiblings(IDs[i],groups);
    
     return;
   }
+
+
+  void Manager::SortSiblings(NodeID_t ID){
+
+    Logger::Scope log(_log_level);
+
+    SortSiblings(ID,nullptr);
+
+    return;
+  }
   
   // Siblings sorting:
   // Either merge siblings (loose == true)
   // or only pick the best one (loose == false)
   // After decision, modify all other correlations
   // accordingly
-  void Manager::SortSiblings(NodeID_t ID){
+  void Manager::SortSiblings(NodeID_t ID, SiblingGroups* groups){
 
-    if (_verbose) { std::cout << "sort siblings for node: " << ID << std::endl; }
+    GEOTREE_DEBUG(msg::kManager, "sort siblings for node: " << ID);
 
-    if (_coll.GetNode(ID).hasSiblings() == false){
-      if (_verbose) { std::cout << "\tno siblings. No issue..." << std::endl; }
+    const Node* node = _coll.FindNode(ID);
+    if ( (node == nullptr) or node->siblings().empty() ){
+      GEOTREE_DEBUG(msg::kManager, "\tno siblings. No issue...");
       return;
     }
 
-    auto siblings = _coll.GetNode(ID).getSiblings();
+    IDList_t siblings;
+    node->getSiblings(siblings);
     if (siblings.size() == 1){
-      if (_verbose) { std::cout << "\tOnly 1 sibling. No issue..." << std::endl; }
+      GEOTREE_DEBUG(msg::kManager, "\tOnly 1 sibling. No issue...");
       return;
     }
 
+    // settled group: the correlations among its members are sibling
+    // correlations with score 0 at the group vertex. If the siblings
+    // of this node are the rest of the group there is nothing to do
+    size_t idx = 0;
+    if (groups != nullptr){
+      idx = _coll.FindIndex(ID);
+      if ( groups->Settled(idx) and (groups->Members(idx) == siblings.size()+1) ){
+	size_t const group = groups->Find(idx);
+	bool inGroup = true;
+	for (auto& sID : siblings){
+	  if (groups->Find(_coll.FindIndex(sID)) != group){
+	    inGroup = false;
+	    break;
+	  }
+	}
+	if (inGroup){
+	  GEOTREE_DEBUG(msg::kManager, "\tsibling group already settled");
+	  _stats.Count(ManagerStats::kSiblingSortSkipped);
+	  return;
+	}
+      }
+      for (auto& sID : siblings)
+	groups->Merge(idx,_coll.FindIndex(sID));
+    }
+
     // If there are multiple siblings but with the same vertex
     // -> then we are good to go. Everything is in agreement
     bool AllSame = true;
-    auto const vtx1 = _coll.GetNode(ID).getVtx(siblings[0]);
+    VertexID_t const vtx1 = node->findCorrelation(siblings[0])->VtxID();
     for (size_t i=1; i < siblings.size(); i++){
-      auto const vtx2 = _coll.GetNode(ID).getVtx(siblings[i]);
-      if (vtx1 != vtx2){
+      VertexID_t const vtx2 = node->findCorrelation(siblings[i])->VtxID();
+      if (_coll.Vertices().Same(vtx1,vtx2) == false){
 	AllSame = false;
 	break;
       }
@@ -433,15 +1420,18 @@ namespace geotree{
 	for (size_t s2 = s1+1; s2 < siblings.size(); s2++){
 	  // are they correlated?
 	  if (_loose){
-	    if ( _coll.GetNode(siblings[s1]).isCorrelated(siblings[s2]) == true){
-	      // remove that correlation and replace it with a sibling correlation
-	      EraseCorrelation(siblings[s1],siblings[s2]);
-	    }
-	    if (_verbose) { std::cout << "\tAbout to add sibling correlation..." << std::endl; }
-	    AddCorrelation(siblings[s1],siblings[s2],0.,vtx1,::geotree::RelationType_t::kSibling);
+	    // remove any correlation and replace it with a sibling correlation
+	    TryEraseCorrelation(siblings[s1],siblings[s2]);
+	    GEOTREE_DEBUG(msg::kManager, "\tAbout to add sibling correlation...");
+	    TryAddCorrelationAt(siblings[s1],siblings[s2],0.,vtx1,::geotree::RelationType_t::kSibling);
 	  }
 	}
       }
+      if ( (groups != nullptr) and (groups->Members(idx) == siblings.size()+1) and
+	   SiblingGroupSettled(ID,siblings,vtx1) ){
+	groups->SetVertex(idx,vtx1);
+	groups->Settle(idx);
+      }
       return;
     }
     
@@ -453,31 +1443,62 @@ namespace geotree{
       std::vector<::geoalgo::Vector_t> siblingVtxList;
       // siblings contains NodeID of all siblings. Use to get vtx
       for (auto& sID : siblings)
-	siblingVtxList.push_back(_coll.GetNode(ID).getVtx(sID));
+	siblingVtxList.push_back(_coll.Vertex(node->findCorrelation(sID)->VtxID()));
       // find "average" vertex location
-      if (_verbose) { 
-	std::cout << "\tFind Bounding Sphere from points: " << std::endl;
+      if (GEOTREE_LOG_ENABLED(msg::kManager,msg::kDEBUG)){
+	GEOTREE_DEBUG(msg::kManager, "\tFind Bounding Sphere from points: ");
 	for (size_t v=0; v < siblingVtxList.size(); v++)
-	  std::cout << "\tSib: " << siblings[v] << "\tVtx: "<< siblingVtxList[v] << std::endl;
+	  GEOTREE_DEBUG(msg::kManager, "\tSib: " << siblings[v] << "\tVtx: "<< siblingVtxList[v]);
       }
       ::geoalgo::Point_t newVtx = _geoAlgo.boundingSphere(siblingVtxList).Center();
-      if (_verbose) { std::cout << "\taverage vtx from " << siblings.size() << " siblings is: " << newVtx << std::endl; }
-      // edit all correlations so that vertices are updated.
+      GEOTREE_DEBUG(msg::kManager, "\taverage vtx from " << siblings.size() << " siblings is: " << newVtx);
+      // all correlations within the group share one vertex:
+      // the vertex IDs of the node's sibling correlations...
+      _group_vtx.clear();
       for (auto& sID : siblings)
-	EditCorrelation(ID,sID,newVtx);
-      // also, we need to add all sibling correlations from node ID to its sisters
+	_group_vtx.push_back(node->findCorrelation(sID)->VtxID());
+      // ...and of the sibling correlations among its sisters
       for (size_t s1 = 0; s1 < siblings.size()-1; s1++){
 	for (size_t s2 = s1+1; s2 < siblings.size(); s2++){
-	  // if this correlation already exits -> just edit the vertex info
-	  if (_coll.GetNode(siblings[s1]).isCorrelated(siblings[s2])){
+	  auto const corr = _coll.FindNode(siblings[s1])->findCorrelation(siblings[s2]);
+	  if (corr != nullptr){
 	    // if correlation is not sibling then throw exception!
-	    if (_coll.GetNode(siblings[s1]).getRelation(siblings[s2]) != ::geotree::RelationType_t::kSibling)
+	    if (corr->Relation() != ::geotree::RelationType_t::kSibling)
 	      throw ::geoalgo::GeoAlgoException("About to edit what you think is sibling relation but is not!");
-	    EditCorrelation(siblings[s1],siblings[s2],newVtx);
+	    _group_vtx.push_back(corr->VtxID());
+	  }
+	}
+      }
+      // merged in place where the group holds the whole class. A
+      // class shared with correlations outside the group (an earlier
+      // group of a sister) is not moved: those correlations get an alias
+      VertexID_t const merged = _coll.EditVertices().MergeGroup(_group_vtx,std::move(newVtx),_group_scratch);
+      size_t k = 0;
+      for (auto& sID : siblings){
+	auto const corr = _coll.FindNode(ID)->findCorrelation(sID);
+	if (corr->VtxID() != _group_vtx[k]){
+	  EditCorrelationOwn(ID,sID,corr->Score(),_group_vtx[k],::geotree::RelationType_t::kSibling);
+	  _stats.Count(ManagerStats::kSiblingVertexEdited);
+	}
+	else
+	  _stats.Count(ManagerStats::kSiblingVertexMerged);
+	k += 1;
+      }
+      for (size_t s1 = 0; s1 < siblings.size()-1; s1++){
+	for (size_t s2 = s1+1; s2 < siblings.size(); s2++){
+	  auto const corr = _coll.FindNode(siblings[s1])->findCorrelation(siblings[s2]);
+	  if (corr != nullptr){
+	    if (corr->VtxID() != _group_vtx[k]){
+	      EditCorrelationOwn(siblings[s1],siblings[s2],corr->Score(),_group_vtx[k],::geotree::RelationType_t::kSibling);
+	      _stats.Count(ManagerStats::kSiblingVertexEdited);
+	    }
+	    else
+	      _stats.Count(ManagerStats::kSiblingVertexMerged);
+	    k += 1;
 	  }// if the two siblings are already correlated
 	  else{
 	    // if not
-	    AddCorrelation(siblings[s1],siblings[s2],0.,newVtx,::geotree::RelationType_t::kSibling);
+	    TryAddCorrelationAt(siblings[s1],siblings[s2],0.,merged,::geotree::RelationType_t::kSibling);
 	  }
 	}
       }
@@ -487,17 +1508,17 @@ namespace geotree{
       double maxScore = 0.;
       NodeID_t bestSibling = -1;
       for (auto& sID : siblings){
-	double score = _coll.GetNode(ID).getScore(sID);
+	double score = node->findCorrelation(sID)->Score();
 	if (score > maxScore){
 	  maxScore = score;
 	  bestSibling = sID;
 	}
       }// for all siblings
-      if (_verbose) { std::cout << "\tBest Correlation with Node " << bestSibling << " (score = " << maxScore << ")" << std::endl; }
+      GEOTREE_DEBUG(msg::kManager, "\tBest Correlation with Node " << bestSibling << " (score = " << maxScore << ")");
       // now erase correlation with all other siblings
       for (auto& sID : siblings){
 	if (sID != bestSibling)
-	  EraseCorrelation(ID,sID);
+	  TryEraseCorrelation(ID,sID);
       }
     }// if we should just keep the best correlation
     
@@ -505,50 +1526,132 @@ namespace geotree{
   }
 
 
+  void Manager::MatchSiblings(){
+
+    auto const& IDs = _coll.GetNodeIDs();
+    auto const& vertices = _coll.Vertices();
+    _matching.Reset();
+
+    // conflicts (siblings at more than one vertex)
+    // with their sibling correlations
+    for (size_t i=Candidate(ConflictCensus::kMultipleSiblings,0); i < IDs.size();
+	 i=Candidate(ConflictCensus::kMultipleSiblings,i+1)){
+      auto const siblings = _coll.NodeAt(i).siblings();
+      if (siblings.size() < 2)
+	continue;
+      VertexID_t const vtx1 = siblings.begin()->VtxID();
+      bool conflict = false;
+      for (auto const& sib : siblings){
+	if (vertices.Same(vtx1,sib.VtxID()) == false){
+	  conflict = true;
+	  break;
+	}
+      }
+      if (conflict == false)
+	continue;
+      _matching.AddConflict(IDs[i]);
+      for (auto const& sib : siblings)
+	_matching.AddEdge(sib.ID(),sib.Score());
+    }
+    if (_matching.NConflicts() == 0)
+      return;
+
+    size_t const kept = _matching.Solve();
+    GEOTREE_DEBUG(msg::kManager, "sibling matching: " << kept << " of "
+		  << _matching.Edges().size() << " sibling correlations kept");
+
+    for (auto const& e : _matching.Edges())
+      if (e.kept == false)
+	TrustedErase(e.lo,e.hi);
+    _stats.Count(ManagerStats::kSiblingMatched,kept);
+
+    return;
+  }
+
+
+  bool Manager::SiblingGroupSettled(NodeID_t ID, const IDList_t& siblings, VertexID_t vtx) const {
+
+    // no sibling outside the group, and every pair in the group
+    // (this node and its siblings) correlated as siblings with
+    // score 0 at the group's vertex
+    auto const& vertices = _coll.Vertices();
+    VertexID_t const group = vertices.Find(vtx);
+    auto final = [&](const CorrelationEntry* corr) {
+      return ( (corr != nullptr) and
+	       (corr->Relation() == ::geotree::RelationType_t::kSibling) and
+	       (corr->Score() == 0.) and
+	       (vertices.Find(corr->VtxID()) == group) );
+    };
+    for (size_t s1 = 0; s1 < siblings.size(); s1++){
+      const Node* node = _coll.FindNode(siblings[s1]);
+      if (node->nSiblings() != siblings.size())
+	return false;
+      if (final(node->findCorrelation(ID)) == false)
+	return false;
+      for (size_t s2 = s1+1; s2 < siblings.size(); s2++){
+	if (final(node->findCorrelation(siblings[s2])) == false)
+	  return false;
+      }
+    }
+
+    return true;
+  }
+
+
   void Manager::ParentIsSiblingsSibling(){
 
-    // Get list of nodes
-    auto const IDs = _coll.GetNodeIDs();
+    Logger::Scope log(_log_level);
 
-    for (auto &ID : IDs)
-      ParentIsSiblingsSibling(ID);
+    ManagerStats::ScopedTimer timer(_stats,ManagerStats::kParentIsSiblingsSibling);
+
+    auto const& IDs = _coll.GetNodeIDs();
+    for (size_t i=Candidate(ConflictCensus::kParentSibling,0); i < IDs.size();
+	 i=Candidate(ConflictCensus::kParentSibling,i+1))
+      ParentIsSiblingsSibling(IDs[i]);
 
     return;
   }
 
   void Manager::ParentIsSiblingsSibling(NodeID_t ID){
 
-    if (_verbose) { std::cout << "Figuring out if node " << ID << " has parent-sibling conflict" << std::endl; }
+    Logger::Scope log(_log_level);
+
+    GEOTREE_DEBUG(msg::kManager, "Figuring out if node " << ID << " has parent-sibling conflict");
 
     // if node has parent and sibling
     // make sure sibling is not sibling with parent
-    if (_coll.GetNode(ID).hasConflict() == false)
+    const Node* node = _coll.FindNode(ID);
+    if ( (node == nullptr) or node->siblings().empty() )
+      return;
+    NodeID_t parentID;
+    if (node->tryGetParent(parentID) != kSuccess)
       return;
 
     // get siblings
-    auto const siblings = _coll.GetNode(ID).getSiblings();
-    // get parent
-    auto const parentID = _coll.GetNode(ID).getParent();
-    
+    IDList_t siblings;
+    node->getSiblings(siblings);
+
     for (auto& s : siblings){
       // check if sibling is related to parent.
       // if their relation is not that of parent-child
       // need to fix things
-      if (_coll.GetNode(s).isCorrelated(parentID) == false)
+      auto const corr = _coll.FindNode(s)->findCorrelation(parentID);
+      if (corr == nullptr)
 	continue;
       // ok they are correlated. what is the correlation type
-      auto rel = _coll.GetNode(s).getRelation(parentID);
+      auto rel = corr->Relation();
       // if this relation is not parentID is parent of s we have a problem
       if ( rel == ::geotree::RelationType_t::kParent )
 	continue;
 
-      if (_verbose) { std::cout << "\tsibling " << s << " and parent "
-			      << parentID <<  " relation is not logically consistent" << std::endl; }
+      GEOTREE_DEBUG(msg::kManager, "\tsibling " << s << " and parent "
+		    << parentID <<  " relation is not logically consistent");
 
       // Ok, let's give the algorithm a shot! 
       // call the algorithm with node & parent, and sibling
-      if (_verbose) { std::cout << "\talgoMultipleParents called..." << std::endl; }
+      GEOTREE_DEBUG(msg::kManager, "\talgoMultipleParents called...");
       _algoParentIsSiblingsSibling->ResolveConflict(ID,parentID,s);
+      _stats.Count(ManagerStats::kAlgoParentIsSiblingsSibling);
 
       // now loop through correlations found and act on them
       ApplyAlgoCorrelations(_algoParentIsSiblingsSibling->GetCorrelations());
@@ -560,11 +1663,14 @@ namespace geotree{
 
   void Manager::GenericConflict(){
 
-    // Get list of nodes
-    auto const IDs = _coll.GetNodeIDs();
+    Logger::Scope log(_log_level);
 
-    for (auto &ID : IDs)
-      GenericConflict(ID);
+    ManagerStats::ScopedTimer timer(_stats,ManagerStats::kGenericConflict);
+
+    auto const& IDs = _coll.GetNodeIDs();
+    for (size_t i=Candidate(ConflictCensus::kParentSibling,0); i < IDs.size();
+	 i=Candidate(ConflictCensus::kParentSibling,i+1))
+      GenericConflict(IDs[i]);
 
     return;
   }
@@ -572,22 +1678,28 @@ namespace geotree{
   // If there is a conflict and siblings don't have the same parent -> remove sibling relation
   void Manager::GenericConflict(NodeID_t ID){
 
+    Logger::Scope log(_log_level);
+
     // if node has parent and sibling
     // do something if sibling does not have a parent
-    if (_coll.GetNode(ID).hasConflict() == false)
-      return;    
+    const Node* node = _coll.FindNode(ID);
+    if ( (node == nullptr) or node->siblings().empty() )
+      return;
+    NodeID_t parentID;
+    if (node->tryGetParent(parentID) != kSuccess)
+      return;
 
-    if (_verbose) { std::cout << "Node has conflict...if siblings do not agree resolve" << std::endl; } 
+    GEOTREE_DEBUG(msg::kManager, "Node has conflict...if siblings do not agree resolve"); 
 
     // get siblings
-    auto const siblings = _coll.GetNode(ID).getSiblings();
-    // get parent
-    auto const parentID = _coll.GetNode(ID).getParent();    
+    IDList_t siblings;
+    node->getSiblings(siblings);
 
     for (auto& s : siblings){
       
-      if (_verbose) { std::cout << "\talgoGenericConflict called..." << std::endl; }
+      GEOTREE_DEBUG(msg::kManager, "\talgoGenericConflict called...");
       _algoGenericConflict->ResolveConflict(ID,parentID,s);
+      _stats.Count(ManagerStats::kAlgoGenericConflict);
 
       // now loop through correlations found and act on them
       ApplyAlgoCorrelations(_algoGenericConflict->GetCorrelations());
@@ -601,6 +1713,12 @@ namespace geotree{
   void Manager::ApplyAlgoCorrelations(const std::map< std::pair<NodeID_t, NodeID_t>, geotree::Correlation>& algoCorrs){
 
 
+      // consecutive correlations at the same point share one vertex
+      // (an alias each: a correlation's vertex ID is its own)
+      bool interned = false;
+      ::geoalgo::Point_t lastVtx;
+      VertexID_t lastID = 0;
+
       std::map< std::pair<NodeID_t,NodeID_t>, geotree::Correlation >::const_iterator corrit;
       for (corrit = algoCorrs.begin(); corrit != algoCorrs.end(); corrit++){
 	// nodes involved
@@ -608,20 +1726,110 @@ namespace geotree{
 	NodeID_t n2 = (corrit->first).second;
 	// if correlation's score is negative -> remove
 	if (corrit->second.Score() < 0)
-	  EraseCorrelation(n1,n2);
+	  TrustedErase(n1,n2);
 	// if the correlation score is > 0
 	// either we need to create a new
 	// one if none exists or we need
 	// to edit an already existing
 	// correlation
-	else if (_coll.GetNode(n1).isCorrelated(n2) == true)
-	  EditCorrelation(n1,n2,corrit->second.Score(),corrit->second.Vtx(),corrit->second.Relation());
-	else
-	  AddCorrelation(n1,n2,corrit->second.Score(),corrit->second.Vtx(),corrit->second.Relation());
+	else{
+	  auto const& c = corrit->second;
+	  VertexID_t vtx;
+	  if ( (interned == false) or (c.Vtx() != lastVtx) ){
+	    lastVtx  = c.Vtx();
+	    lastID   = _coll.EditVertices().Add(c.Vtx());
+	    vtx      = lastID;
+	    interned = true;
+	  }
+	  else
+	    vtx = _coll.EditVertices().Alias(lastID);
+	  TrustedSet(n1,n2,c.Score(),vtx,c.Relation());
+	}
       }// for correlations returned by the algorithm
 
     return;
   }
+
+
+  void Manager::TrustedSet(const NodeID_t id1, const NodeID_t id2,
+			   const double score,
+			   const VertexID_t vtx,
+			   const geotree::RelationType_t type){
+
+    size_t const pos1 = _coll.FindIndex(id1);
+    size_t const pos2 = _coll.FindIndex(id2);
+    const Node& node1 = _coll.NodeAt(pos1);
+    const Node& node2 = _coll.NodeAt(pos2);
+
+    //type returned is the relation of 1 w.r.t. 2
+    // find "inverse" relation to assign to 2 w.r.t. 1
+    geotree::RelationType_t otherRel = InverseRelation(type);
+
+    if ( node1.isProhibited(otherRel) ||
+	 node2.isProhibited(type) ){
+      GEOTREE_DEBUG(msg::kManager, "\tCorrelation is Prohibited!");
+      return;
+    }
+
+    size_t const at1 = node1.locate(id2);
+    size_t const at2 = node2.locate(id1);
+    bool const exists = (at2 < node2.nCorrelations());
+    GEOTREE_CHECK(exists == (at1 < node1.nCorrelations()), "TrustedSet: correlation stored by one node only!");
+
+    if (_undo.Active())
+      _undo.Save(id1,id2,
+		 exists ? &node1.correlationAt(at1) : nullptr,
+		 exists ? &node2.correlationAt(at2) : nullptr);
+
+    Node* edit1 = _coll.EditNodeAt(pos1);
+    Node* edit2 = _coll.EditNodeAt(pos2);
+    if (exists){
+      GEOTREE_DEBUG(msg::kManager, "\tEditing Correlation...");
+      edit2->editAt(at2,score,vtx,type);
+      edit1->editAt(at1,score,vtx,otherRel);
+      _stats.Count(ManagerStats::kCorrelationEdited);
+    }
+    else{
+      GEOTREE_DEBUG(msg::kManager, "\tAdding Correlation...");
+      edit2->insertCorrelation(CorrelationEntry(id1,score,vtx,type));
+      edit1->insertCorrelation(CorrelationEntry(id2,score,vtx,otherRel));
+      _stats.Count(ManagerStats::kCorrelationAdded);
+    }
+    TouchedAt(pos1,pos2);
+
+    return;
+  }
+
+
+  void Manager::TrustedErase(const NodeID_t id1, const NodeID_t id2){
+
+    size_t const pos1 = _coll.FindIndex(id1);
+    size_t const pos2 = _coll.FindIndex(id2);
+    const Node& node1 = _coll.NodeAt(pos1);
+    const Node& node2 = _coll.NodeAt(pos2);
+
+    size_t const at1 = node1.locate(id2);
+    size_t const at2 = node2.locate(id1);
+    bool const has1 = (at1 < node1.nCorrelations());
+    bool const has2 = (at2 < node2.nCorrelations());
+    if ( (has1 == false) and (has2 == false) )
+      return;
+    GEOTREE_CHECK(has1 == has2, "TrustedErase: correlation stored by one node only!");
+
+    GEOTREE_DEBUG(msg::kManager, "\tRemoving Correlation...");
+
+    if (_undo.Active())
+      _undo.Save(id1,id2,
+		 has1 ? &node1.correlationAt(at1) : nullptr,
+		 has2 ? &node2.correlationAt(at2) : nullptr);
+
+    if (has1) _coll.EditNodeAt(pos1)->eraseAt(at1);
+    if (has2) _coll.EditNodeAt(pos2)->eraseAt(at2);
+    TouchedAt(pos1,pos2);
+    _stats.Count(ManagerStats::kCorrelationErased);
+
+    return;
+  }
   
 }
 
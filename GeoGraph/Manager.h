@@ -16,6 +16,15 @@
 
 #include "GeoAlgo/GeoAlgo.h"         //-> for bounding sphere
 #include "NodeCollection.h"          //-> where nodes are stored
+#include "ManagerStats.h"            //-> timers and counters
+#include "MemoryUsage.h"             //-> memory report
+#include "UndoLog.h"                 //-> transactions
+#include "SiblingGroups.h"           //-> sibling sets
+#include "SiblingMatching.h"         //-> strict-mode sibling pairs
+#include "ConflictCensus.h"          //-> conflict candidates
+#include "ForestPublisher.h"         //-> forests for reader threads
+#include "PruneConfig.h"             //-> pruning pass settings
+#include "Logger.h"                  //-> debug messages
 //#include "AlgoMultipleParentsBase.h" //-> algorithm to resolve conflict due to multiple parents
 #include "AlgoMultipleParentsHighScore.h"
 #include "AlgoParentIsSiblingsSibling.h"
@@ -23,6 +32,16 @@
 
 namespace geotree{
 
+  /// parent-child correlation removed to break a cycle of parents
+  /// (see Manager::BreakCycles)
+  struct CycleEdge_t{
+    NodeID_t parent;
+    NodeID_t child;
+    double score;
+    /// number of nodes in the cycle (strongly connected component)
+    size_t cycleSize;
+  };
+
   /**
      \class geotree::Manager
      Class where information for all nodes in event is stored
@@ -39,8 +58,56 @@ namespace geotree{
     /// Default destructor
     virtual ~Manager(){}
 
-    /// Reset function
-    void Reset() { _coll.Reset(); }
+    /// Reset function (container capacity is kept for the next event)
+    void Reset();
+
+    /// Snapshot of the correlation graph. Cheap: nodes are shared
+    /// with the manager and copied only when one side modifies them,
+    /// so several configurations (loose / strict, ...) can be run on
+    /// the same ingested event, also on different threads:
+    /// auto snap = mgr.Snapshot(); other.LoadSnapshot(snap); other.setLoose(true);
+    NodeCollection Snapshot() const { return _coll; }
+
+    /// Replace the current event with a snapshot (shares its nodes).
+    /// Open transactions are dropped, and so is the forest of the
+    /// previous event (LastForest is empty until the next MakeTree;
+    /// the published one stays until then)
+    void LoadSnapshot(const NodeCollection& snap) { _undo.Clear(); _coll = snap; _forest.Clear(); InvalidateLazy(); }
+
+    /// Transactions: correlation edits made after BeginTransaction
+    /// (by the user or by the resolution passes) are logged and can
+    /// be undone with Rollback or kept with Commit. Transactions nest.
+    /// MakeTree cannot be called inside a transaction; Reset and
+    /// LoadSnapshot drop open transactions.
+    void BeginTransaction() { _undo.Begin(_coll); }
+
+    /// Keep the edits of the innermost transaction
+    void Commit() { _undo.Commit(); }
+
+    /// Undo the edits of the innermost transaction
+    void Rollback();
+
+    /// Number of open transactions
+    size_t TransactionDepth() const { return _undo.Depth(); }
+
+    /// Presize internal containers for events with up to this many
+    /// nodes and correlations. Capacity survives Reset()
+    void Reserve(size_t nodes, size_t correlations);
+
+    /// Estimated memory currently held, in bytes
+    MemoryUsage_t MemoryUsage() const;
+
+    /// Largest MemoryUsage() (by total) seen at the end of
+    /// ResolveConflicts / MakeTree or before a Reset since the last
+    /// ResetPeakMemoryUsage(). Only recorded with setMemoryTracking(true)
+    const MemoryUsage_t& PeakMemoryUsage() const { return _peak_memory; }
+
+    /// Clear the peak memory record
+    void ResetPeakMemoryUsage() { _peak_memory = MemoryUsage_t(); }
+
+    /// Enable / disable peak tracking (default off: each update is
+    /// a pass over all nodes and containers, up to three per event)
+    void setMemoryTracking(bool on) { _track_memory = on; }
 
     /// Set Objects (TEMP)
     void setObjects(size_t n);
@@ -49,8 +116,63 @@ namespace geotree{
     NodeID_t FindID(size_t idx) { return _coll.FindID(idx); }
 
     /// Function to call when to make tree
+    /// (runs BreakCycles first). The forest is then built
+    /// (see LastForest) and published (see GetForest)
     void MakeTree();
 
+    /// Forest made by the last MakeTree (empty after Reset).
+    /// Same thread as the manager
+    const Forest& LastForest() const { return _forest; }
+
+    /// Threads used to build the forest of large events
+    /// (see Forest::Build; default 1)
+    void setForestThreads(size_t n) { _forest_threads = (n > 0) ? n : 1; }
+    size_t getForestThreads() const { return _forest_threads; }
+
+    /// Latest published forest, from any thread and without locks,
+    /// also while the manager works on the next event: the forest
+    /// stays as it is while the returned handle exists. Empty handle
+    /// if no forest was published yet. Publication is skipped (and
+    /// counted as ForestNotPublished) only if readers hold every
+    /// other slot. Handles must not outlive the manager
+    ForestPublisher::Reader GetForest() const { return _published.Read(); }
+
+    /// Enable / disable publication of the forests made by MakeTree
+    /// (default on). Off for helper managers whose trees readers of
+    /// GetForest should not see
+    void setPublishing(bool on) { _publish = on; }
+
+    /// Lazy trees, an alternative to ResolveConflicts + MakeTree when
+    /// only a few trees are needed: only the connected component of
+    /// the node (nodes linked by correlations of any type) is resolved
+    /// and made into trees, with the result ResolveConflicts + MakeTree
+    /// would give for it. The component's forest is cached until a
+    /// correlation of the component changes (or the manager is Reset,
+    /// resolved, rolled back, or its settings change). Queries work on
+    /// the correlations as loaded / edited: they leave the manager's
+    /// nodes unchanged, and are not meant to follow MakeTree.
+    /// Synthetic nodes get IDs above those of the event (the same IDs
+    /// may be used in two components).
+    /// The returned forest is valid until the next query.
+    /// Subtree: the node and everything below it (the node is the head)
+    const Forest& Subtree(NodeID_t root);
+    /// TreeOf: the whole tree the node is in (its head may be a synthetic node)
+    const Forest& TreeOf(NodeID_t id);
+
+    /// Break the cycles of parent relations (A parent of B, B parent
+    /// of C, C parent of A), which would make the tree recursion
+    /// (NodeAdded, Diagram) loop forever. Cycles are found as the
+    /// strongly connected components of the parent graph (iterative
+    /// Tarjan, O(V+E), no recursion); in each one the parent-child
+    /// correlation with the lowest score (lowest IDs on ties) is
+    /// removed. Components that still hold a cycle are searched
+    /// again until none is left. Each removal is reported as a
+    /// warning. Returns the number of correlations removed
+    size_t BreakCycles();
+
+    /// correlations removed by the last BreakCycles
+    const std::vector<CycleEdge_t>& GetBrokenCycles() const { return _broken_cycles; }
+
     /// Print correlation matrix
     void CorrelationMatrix() { _coll.CorrelationMatrix(); }
 
@@ -60,6 +182,61 @@ namespace geotree{
     /// Function to find node in _head_node_v. Return true if found
     bool NodeAdded(NodeID_t n);
 
+    /// Bulk interface: whole events in and forests out through
+    /// contiguous arrays, so that PyROOT can pass NumPy buffers
+    /// without per-element calls or copies (see mac/bulk.py).
+    /// Array types: IDs int64, scores / vertices float64 (vtx has 3
+    /// values per row: x,y,z), relation types and depths int32.
+
+    /// Load an event of n correlations (id2 is type w.r.t. id1, as in
+    /// AddCorrelation). The manager is Reset first. Nodes are made from
+    /// the nnodes IDs in nodes, in that order; if nodes is nullptr one
+    /// node is made per distinct ID of the correlations, in increasing
+    /// ID order (nodes without correlations are then left out).
+    /// Returns the number of nodes
+    size_t LoadArrays(size_t nnodes, const long* nodes,
+		      size_t n, const long* id1, const long* id2,
+		      const double* score, const double* vtx, const int* type);
+
+    /// Sibling groups found by the last MakeTree (indices are
+    /// node positions, see NodeCollection::FindIndex): each group
+    /// of more than one node got one synthetic parent, with the
+    /// group's vertex and highest sibling score.
+    /// Valid until the next ResolveConflicts
+    const SiblingGroups& GetSiblingGroups() const { return _siblings; }
+
+    /// Number of nodes, including the ones made by MakeTree
+    size_t NodeCount() const { return _coll.GetNodeIDs().size(); }
+
+    /// Write the forest made by the last MakeTree (see LastForest)
+    /// into arrays with room for capacity nodes (at least
+    /// NodeCount()), one row per node:
+    /// - id: node ID
+    /// - parent: row of the parent node, -1 for head nodes
+    /// - depth: 0 for head nodes, -1 for nodes not in the tree
+    /// - vtx: vertex the node comes from: the one shared with its
+    ///   siblings if it has any, otherwise that of the correlation
+    ///   with its parent (NaN if neither)
+    /// Returns the number of rows written
+    size_t FillForestArrays(size_t capacity, long* id, long* parent,
+			    int* depth, double* vtx) const;
+
+    /// Resolve nev events in one call. The correlations of event e are
+    /// rows [offsets[e], offsets[e+1]) of the input arrays, its node IDs
+    /// rows [nodeInOffsets[e], nodeInOffsets[e+1]) of nodeIn (both
+    /// offset arrays have nev+1 entries; nodeIn and nodeInOffsets may be
+    /// nullptr, see LoadArrays). Each event is loaded, resolved and made
+    /// into a tree; its forest is appended to the output arrays (room for
+    /// capacity rows: twice the number of nodes is always enough) at rows
+    /// [nodeOffsets[e], nodeOffsets[e+1]), parent rows relative to the
+    /// event. ok[e] is 0 for an event that failed (no rows written).
+    /// Returns the number of rows written
+    size_t ResolveBatch(size_t nev, const long* nodeInOffsets, const long* nodeIn,
+			const long* offsets, const long* id1, const long* id2,
+			const double* score, const double* vtx, const int* type,
+			size_t capacity, long* id, long* parent,
+			int* depth, double* vtxOut, long* nodeOffsets, int* ok);
+
     /// CompareNodes: act on result of correlation check
     /// NOTE: RelationType is the relatioship of id2 w.r.t. id1
     /// eg: type == Child => id2 is Child of id1
@@ -88,16 +265,106 @@ namespace geotree{
     /// Erase a correlation completely
     void EraseCorrelation(const NodeID_t id1, const NodeID_t id2);
 
+    /// Versions of the functions above used by the conflict
+    /// resolution. Failures are returned as a status (kNodeNotFound,
+    /// kProhibited, kCorrelationExists, kCorrelationNotFound); only
+    /// running out of memory (std::bad_alloc) still throws
+    Status_t TryAddCorrelation(const NodeID_t id1, const NodeID_t id2,
+			       const double score,
+			       const geoalgo::Point_t& vtx,
+			       const geotree::RelationType_t type);
+
+    Status_t TryEditCorrelation(const NodeID_t id1, const NodeID_t id2,
+				const double score,
+				const geoalgo::Point_t& vtx,
+				const geotree::RelationType_t type);
+
+    Status_t TryEditCorrelation(const NodeID_t id1, const NodeID_t id2,
+				const double score);
+
+    Status_t TryEditCorrelation(const NodeID_t id1, const NodeID_t id2,
+				const geoalgo::Point_t& vtx);
+
+    Status_t TryEditCorrelation(const NodeID_t id1, const NodeID_t id2,
+				const geotree::RelationType_t type);
+
+    Status_t TryEraseCorrelation(const NodeID_t id1, const NodeID_t id2);
+
+    /// Vertices of the event. Each added or edited correlation gets its
+    /// own ID (shared by its two nodes); correlations at a common
+    /// vertex have IDs of one class (see VertexTable)
+    const VertexTable& Vertices() const { return _coll.Vertices(); }
+
+    /// Add / edit a correlation at a vertex already in the table: the
+    /// correlation gets an alias of it, so that they share the point
+    /// (same status codes as above)
+    Status_t TryAddCorrelationAt(const NodeID_t id1, const NodeID_t id2,
+				 const double score,
+				 const VertexID_t vtx,
+				 const geotree::RelationType_t type);
+
+    Status_t TryEditCorrelationAt(const NodeID_t id1, const NodeID_t id2,
+				  const double score,
+				  const VertexID_t vtx,
+				  const geotree::RelationType_t type);
+
     /// Resolve conflicts: each node may have several correlations
     /// find the "best" one and take it as the one that determines
     /// that node's vertex
+    /// (runs Prune first if pruning is enabled). A census of the
+    /// nodes (see GetCensus) decides which nodes each stage visits;
+    /// stages without candidates are skipped
     void ResolveConflicts();
 
-    /// setter for verbosity
-    void setVerbose(bool on) { _verbose = on; _coll.SetVerbose(on); _algoMultipleParents->SetVerbose(on); }
+    /// Take the census in ResolveConflicts (default on). Off: all
+    /// four stages visit every node, as before the census (same
+    /// result; GetCensus stays empty)
+    void setConflictCensus(bool on) { _conflict_census = on; }
+    bool isConflictCensus() const { return _conflict_census; }
+
+    /// Conflicts found by the last ResolveConflicts before resolving
+    /// them (counts per kind, see ConflictCensus). Kept until the next
+    /// ResolveConflicts or Reset
+    const ConflictCensus& GetCensus() const { return _census; }
+
+    /// Remove weak / dominated correlations in one sweep (see PruneConfig)
+    void Prune();
+
+    /// Pruning settings used by ResolveConflicts (default: no pruning)
+    void setPruning(const PruneConfig& cfg) { _prune = cfg; InvalidateLazy(); }
+    const PruneConfig& getPruning() const { return _prune; }
+
+    /// setter for verbosity of this manager: debug messages from all
+    /// GeoTree subsystems while it works (see setLogLevel)
+    void setVerbose(bool on) { _log_level = on ? msg::kDEBUG : msg::kNORMAL; }
+
+    /// Level of all subsystems while this manager works (on the
+    /// thread calling it), whatever the Logger levels are. A
+    /// negative level (default): the Logger levels
+    void setLogLevel(int lvl) { _log_level = lvl; }
+    int getLogLevel() const { return _log_level; }
     
     /// setter for looseness
-    void setLoose(bool on) { _loose = on; }
+    void setLoose(bool on) { if (on != _loose) InvalidateLazy(); _loose = on; }
+
+    /// getter for looseness
+    bool isLoose() const { return _loose; }
+
+    /// strict mode: resolve multiple siblings for all nodes at once
+    /// (see SiblingMatching: a greedy matching, at least half the
+    /// score of the best one) instead of keeping the best sibling of
+    /// each node in node order. Off by default
+    void setSiblingMatching(bool on) { if (on != _sibling_matching) InvalidateLazy(); _sibling_matching = on; }
+    bool isSiblingMatching() const { return _sibling_matching; }
+
+    /// Getter for timers / counters
+    const ManagerStats& GetStats() const { return _stats; }
+
+    /// Clear timers / counters
+    void ResetStats() { _stats.Reset(); }
+
+    /// Enable / disable timers and counters
+    void setStats(bool on) { _stats.SetEnabled(on); }
 
     //****testing**** move these functions private later
     /// Function to resolve sibling conflicts arising form multiple siblings
@@ -113,15 +380,177 @@ namespace geotree{
 
   private:
 
-    /// verbosity flag
-    bool _verbose;
-
     /// looseness flag: if true then merge two vertices (when possible)
     /// rather than picking the best one (e.g. multiple siblings)
     bool _loose;
 
+    /// strict mode: sibling conflicts solved by SiblingMatching
+    bool _sibling_matching;
+
+    /// log level override (see setLogLevel)
+    int _log_level;
+
     /// collection that stores the nodes
     NodeCollection _coll;
+
+    /// timers and counters
+    ManagerStats _stats;
+
+    /// peak tracking
+    bool _track_memory;
+    MemoryUsage_t _peak_memory;
+
+    /// record current memory usage if it is a new peak
+    void UpdatePeakMemory();
+
+    /// undo log for transactions
+    UndoLog _undo;
+
+    /// pruning settings
+    PruneConfig _prune;
+
+    /// correlations removed by BreakCycles
+    std::vector<CycleEdge_t> _broken_cycles;
+
+    /// BreakCycles scratch (Tarjan state by node position)
+    struct CycleScratch_t {
+      std::vector<char> active, next, onStack;
+      std::vector<size_t> index, low, component, stack, members;
+      std::vector< std::pair<size_t,size_t> > frames;
+      void AddMemoryUsage(MemoryUsage_t& usage) const
+      {
+	usage.scratch += active.capacity() + next.capacity() + onStack.capacity()
+	  + (index.capacity() + low.capacity() + component.capacity()
+	     + stack.capacity() + members.capacity())*sizeof(size_t)
+	  + frames.capacity()*sizeof(std::pair<size_t,size_t>);
+      }
+    };
+    CycleScratch_t _cycles;
+
+    /// forest of the last MakeTree, its number and the published ones
+    Forest _forest;
+    size_t _forest_event;
+    size_t _forest_threads;
+    ForestPublisher _published;
+
+    /// MakeTree scratch: node IDs, parent position of each node,
+    /// head positions, nodes already in the tree
+    std::vector<NodeID_t> _tree_ids;
+    std::vector<long> _tree_parent;
+    std::vector<size_t> _tree_heads;
+    std::vector<bool> _tree_added;
+
+    /// sibling groups (built by MakeTree, scratch for SortSiblings)
+    SiblingGroups _siblings;
+
+    /// scratch for MatchSiblings
+    SiblingMatching _matching;
+
+    /// scratch for SortSiblings (loose): vertex IDs of a sibling
+    /// group's correlations, and VertexTable::MergeGroup's buffer
+    std::vector<VertexID_t> _group_vtx;
+    std::vector< std::pair<VertexID_t,VertexID_t> > _group_scratch;
+
+    /// conflict candidates of the event being resolved
+    ConflictCensus _census;
+    /// take the census (see setConflictCensus)
+    bool _conflict_census;
+
+    /// does ResolveConflicts run a stage? (always without census)
+    bool StageNeeded(ConflictCensus::Flag_t flag) const
+    { return (_census.Active() == false) or (_census.Flagged(flag) > 0); }
+
+    /// first node position >= pos that a stage has to visit: every
+    /// position unless ResolveConflicts took a census
+    size_t Candidate(ConflictCensus::Flag_t flag, size_t pos) const
+    { return _census.Active() ? _census.Next(flag,pos) : pos; }
+
+    /// a correlation between two nodes changed: revisit them,
+    /// drop the lazy trees of their components
+    void Touched(const NodeID_t id1, const NodeID_t id2) noexcept;
+    /// same, by node positions
+    void TouchedAt(size_t pos1, size_t pos2) noexcept;
+
+    /// trusted mutations of ApplyAlgoCorrelations (see Invariants.h):
+    /// each node and each entry is looked up once. The algorithms
+    /// propose existing nodes and symmetric correlations, which is
+    /// only checked in GEOTREE_CHECKED builds. Prohibits are set by
+    /// the user and are still honored.
+    /// TrustedSet edits the correlation, or adds it if there is none
+    void TrustedSet(const NodeID_t id1, const NodeID_t id2,
+		    const double score,
+		    const VertexID_t vtx,
+		    const geotree::RelationType_t type);
+    void TrustedErase(const NodeID_t id1, const NodeID_t id2);
+
+    /// lazy trees: a component (node positions, increasing) and its forest
+    struct LazyComponent_t {
+      std::vector<size_t> positions;
+      Forest forest;
+      bool valid;
+      LazyComponent_t() : valid(false) {}
+    };
+    static const size_t kNoComponent = (size_t)-1;
+    std::vector<LazyComponent_t> _lazy;
+    /// slot in _lazy of the component of each node position
+    std::vector<size_t> _lazy_of;
+    /// manager that resolves one component at a time
+    std::unique_ptr<Manager> _lazy_mgr;
+    /// last Subtree / TreeOf result
+    Forest _subtree;
+    /// publish forests (see setPublishing; false for _lazy_mgr)
+    bool _publish;
+
+    /// forest of the component of a node (made if not cached)
+    const Forest& LazyForest(NodeID_t id);
+
+    /// drop all lazy trees / the one of the component of a node position
+    void InvalidateLazy();
+    void InvalidateLazy(size_t pos) noexcept;
+
+    /// sort the siblings of one node. With groups (loose mode, all
+    /// nodes in one pass) the node is skipped if its siblings form
+    /// a group already settled by an earlier node of the pass
+    void SortSiblings(NodeID_t ID, SiblingGroups* groups);
+
+    /// strict mode with setSiblingMatching: keep the sibling
+    /// correlations chosen by SiblingMatching, erase the other
+    /// sibling correlations of the conflicts
+    void MatchSiblings();
+
+    /// are ID and its siblings a settled group at vertex vtx
+    /// (see SiblingGroups::Settled)?
+    bool SiblingGroupSettled(NodeID_t ID, const IDList_t& siblings, VertexID_t vtx) const;
+
+    /// pruning decisions of one node for one relation.
+    /// cand: (score, ID) of the parents or siblings, in ID order (modified)
+    /// pairs to remove are appended to drops
+    static void PruneCandidates(const NodeID_t ID,
+				std::vector< std::pair<double,NodeID_t> >& cand,
+				const double floor, const bool dominated, const size_t maxKeep,
+				std::vector< std::pair<NodeID_t,NodeID_t> >& drops);
+
+    /// checks done before adding / editing a correlation
+    /// (kSuccess if the change can be made)
+    Status_t CheckAdd(const NodeID_t id1, const NodeID_t id2,
+		      const geotree::RelationType_t type) const;
+    Status_t CheckEdit(const NodeID_t id1, const NodeID_t id2,
+		       const geotree::RelationType_t type) const;
+
+    /// add / edit a correlation whose vertex ID is its own
+    /// (new entry or alias; checked by the caller)
+    Status_t AddCorrelationOwn(const NodeID_t id1, const NodeID_t id2,
+			       const double score,
+			       const VertexID_t vtx,
+			       const geotree::RelationType_t type);
+    Status_t EditCorrelationOwn(const NodeID_t id1, const NodeID_t id2,
+				const double score,
+				const VertexID_t vtx,
+				const geotree::RelationType_t type);
+
+    /// save the state of the id1 <-> id2 correlation if a transaction is open
+    void SaveUndo(const NodeID_t id1, const NodeID_t id2,
+		  const Node* node1, const Node* node2);
     
     /// function to find best parent for all nodes
     void FindBestParent();
@@ -132,6 +561,12 @@ namespace geotree{
     /// is this node a subnode of another
     bool IsSubNode(NodeID_t search, NodeID_t top);
 
+    /// relation of id1 w.r.t. id2 given the one of id2 w.r.t. id1
+    static geotree::RelationType_t InverseRelation(const geotree::RelationType_t type);
+
+    /// throw an exception for statuses that are errors at the public boundary
+    static void ThrowOnError(const Status_t status);
+
     /// geoalgo instance to find "average" vertex
     ::geoalgo::GeoAlgo _geoAlgo;
 
@@ -0,0 +1,170 @@
+#ifndef MANAGERSTATS_CXX
+#define MANAGERSTATS_CXX
+
+#include "ManagerStats.h"
+#include <iomanip>
+
+namespace geotree{
+
+  ManagerStats::PhaseProbe_t ManagerStats::_probe = nullptr;
+
+  void LatencyHistogram::Fill(uint64_t ns)
+  {
+
+    // bin = floor(log2(ns))
+    size_t bin = 0;
+    uint64_t v = ns;
+    while ( (v >>= 1) && (bin+1 < kNBins) )
+      bin++;
+
+    _bins[bin] += 1;
+    if ( (_entries == 0) or (ns < _min) ) _min = ns;
+    if (ns > _max) _max = ns;
+    _entries += 1;
+
+    return;
+  }
+
+  void LatencyHistogram::Merge(const LatencyHistogram& other)
+  {
+
+    if (other._entries == 0)
+      return;
+
+    for (size_t i=0; i < kNBins; i++)
+      _bins[i] += other._bins[i];
+    if ( (_entries == 0) or (other._min < _min) ) _min = other._min;
+    if (other._max > _max) _max = other._max;
+    _entries += other._entries;
+
+    return;
+  }
+
+  void LatencyHistogram::Reset()
+  {
+    for (size_t i=0; i < kNBins; i++)
+      _bins[i] = 0;
+    _entries = 0;
+    _min = 0;
+    _max = 0;
+  }
+
+  uint64_t LatencyHistogram::Percentile(double p) const
+  {
+
+    if (_entries == 0)
+      return 0;
+
+    uint64_t rank = (uint64_t)(p*_entries);
+    if (rank >= _entries) rank = _entries-1;
+
+    uint64_t seen = 0;
+    for (size_t i=0; i < kNBins; i++){
+      seen += _bins[i];
+      if (seen > rank){
+	// upper edge of the bin, but never above the largest measurement
+	uint64_t edge = (uint64_t)1 << (i+1);
+	return (edge < _max) ? edge : _max;
+      }
+    }
+
+    return _max;
+  }
+
+  void ManagerStats::Reset()
+  {
+    for (size_t i=0; i < kNCounters; i++)
+      _counters[i] = 0;
+    for (size_t i=0; i < kNPhases; i++){
+      _calls[i] = 0;
+      _time[i]  = 0;
+      _hist[i].Reset();
+    }
+  }
+
+  void ManagerStats::Merge(const ManagerStats& other)
+  {
+    for (size_t i=0; i < kNCounters; i++)
+      _counters[i] += other._counters[i];
+    for (size_t i=0; i < kNPhases; i++){
+      _calls[i] += other._calls[i];
+      _time[i]  += other._time[i];
+      _hist[i].Merge(other._hist[i]);
+    }
+  }
+
+  void ManagerStats::AddTime(Phase_t p, uint64_t ns)
+  {
+    if (_enabled == false)
+      return;
+    _calls[p] += 1;
+    _time[p]  += ns;
+    _hist[p].Fill(ns);
+  }
+
+  const char* ManagerStats::PhaseName(Phase_t p)
+  {
+    switch (p){
+    case kPrune:                   return "Prune";
+    case kFindBestParent:          return "FindBestParent";
+    case kParentIsSiblingsSibling: return "ParentIsSiblingsSibling";
+    case kGenericConflict:         return "GenericConflict";
+    case kSortSiblings:            return "SortSiblings";
+    case kResolveConflicts:        return "ResolveConflicts";
+    case kBreakCycles:             return "BreakCycles";
+    case kMakeTree:                return "MakeTree";
+    default:                       return "Unknown";
+    }
+  }
+
+  const char* ManagerStats::CounterName(Counter_t c)
+  {
+    switch (c){
+    case kAlgoMultipleParents:        return "AlgoMultipleParents";
+    case kAlgoParentIsSiblingsSibling: return "AlgoParentIsSiblingsSibling";
+    case kAlgoGenericConflict:        return "AlgoGenericConflict";
+    case kCorrelationAdded:           return "CorrelationAdded";
+    case kCorrelationEdited:          return "CorrelationEdited";
+    case kCorrelationErased:          return "CorrelationErased";
+    case kSyntheticNode:              return "SyntheticNode";
+    case kUndoneCorrelation:          return "UndoneCorrelation";
+    case kCorrelationPruned:          return "CorrelationPruned";
+    case kSiblingVertexMerged:        return "SiblingVertexMerged";
+    case kSiblingVertexEdited:        return "SiblingVertexEdited";
+    case kSiblingSortSkipped:         return "SiblingSortSkipped";
+    case kCycleEdgeRemoved:           return "CycleEdgeRemoved";
+    case kForestNotPublished:         return "ForestNotPublished";
+    case kConflictStageSkipped:       return "ConflictStageSkipped";
+    case kTrivialEvent:               return "TrivialEvent";
+    case kLazyTreeBuilt:              return "LazyTreeBuilt";
+    case kLazyTreeCached:             return "LazyTreeCached";
+    case kLazyTreeInvalidated:        return "LazyTreeInvalidated";
+    case kSiblingMatched:             return "SiblingMatched";
+    default:                          return "Unknown";
+    }
+  }
+
+  void ManagerStats::Print(std::ostream& out) const
+  {
+
+    out << std::setw(26) << std::left << "Phase" << std::right
+	<< std::setw(10) << "calls" << std::setw(14) << "total [us]"
+	<< std::setw(12) << "mean [us]" << std::setw(12) << "p50 [us]" << std::setw(12) << "p99 [us]" << std::endl;
+    for (size_t i=0; i < kNPhases; i++){
+      double mean = (_calls[i] > 0) ? _time[i]/1.e3/_calls[i] : 0.;
+      out << std::setw(26) << std::left << PhaseName((Phase_t)i) << std::right
+	  << std::setw(10) << _calls[i] << std::setw(14) << _time[i]/1.e3
+	  << std::setw(12) << mean
+	  << std::setw(12) << _hist[i].Percentile(0.5)/1.e3
+	  << std::setw(12) << _hist[i].Percentile(0.99)/1.e3 << std::endl;
+    }
+    for (size_t i=0; i < kNCounters; i++)
+      out << std::setw(26) << std::left << CounterName((Counter_t)i) << std::right
+	  << std::setw(10) << _counters[i] << std::endl;
+
+    return;
+  }
+
+}
+
+#endif
@@ -0,0 +1,208 @@
+/**
+ * \file ManagerStats.h
+ *
+ * \ingroup GeoTree
+ *
+ * \brief Class def header for a class geotree::ManagerStats
+ *
+ * @author david caratelli
+ */
+
+/** \addtogroup GeoTree
+    Timing and counters for the Manager.
+    Each phase of ResolveConflicts / MakeTree is timed
+    with a monotonic clock (total time, number of calls
+    and a log2 histogram of the per-event latency).
+    Counters keep track of algorithm invocations,
+    correlations added / edited / erased and synthetic
+    nodes created.
+    Stats from different Managers (e.g. one per thread)
+    can be combined with Merge.
+    A process-wide probe can be told when each phase starts
+    and ends (see SetPhaseProbe), e.g. to attribute heap
+    allocations to phases (bin/allocations.cc).
+    @{*/
+#ifndef MANAGERSTATS_H
+#define MANAGERSTATS_H
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+
+namespace geotree{
+
+  /**
+     \class geotree::LatencyHistogram
+     Histogram of latencies in nanoseconds with
+     power-of-two bins: bin i holds [2^i, 2^(i+1)) ns
+  */
+  class LatencyHistogram{
+
+  public:
+
+    static const size_t kNBins = 48;
+
+    /// Default constructor
+    LatencyHistogram() { Reset(); }
+
+    /// Add one measurement (ns)
+    void Fill(uint64_t ns);
+
+    /// Add the content of another histogram
+    void Merge(const LatencyHistogram& other);
+
+    /// Clear the histogram
+    void Reset();
+
+    /// Number of entries
+    uint64_t Entries() const { return _entries; }
+
+    /// Content of a bin
+    uint64_t BinContent(size_t bin) const { return _bins[bin]; }
+
+    /// Lower edge (ns) of a bin
+    static uint64_t BinLowEdge(size_t bin) { return (bin == 0) ? 0 : (uint64_t)1 << bin; }
+
+    /// Approximate percentile (ns, upper edge of the bin holding it). p in [0,1]
+    uint64_t Percentile(double p) const;
+
+    /// Smallest / largest measurement (ns)
+    uint64_t Min() const { return _entries ? _min : 0; }
+    uint64_t Max() const { return _max; }
+
+  private:
+
+    uint64_t _bins[kNBins];
+    uint64_t _entries;
+    uint64_t _min;
+    uint64_t _max;
+
+  };
+
+  class ManagerStats{
+
+  public:
+
+    /// Phases which are timed
+    enum Phase_t {
+      kPrune,
+      kFindBestParent,
+      kParentIsSiblingsSibling,
+      kGenericConflict,
+      kSortSiblings,
+      kResolveConflicts,
+      kBreakCycles,
+      kMakeTree,
+      kNPhases
+    };
+
+    /// Counters
+    enum Counter_t {
+      kAlgoMultipleParents,
+      kAlgoParentIsSiblingsSibling,
+      kAlgoGenericConflict,
+      kCorrelationAdded,
+      kCorrelationEdited,
+      kCorrelationErased,
+      kSyntheticNode,
+      kUndoneCorrelation,
+      kCorrelationPruned,
+      kSiblingVertexMerged,
+      kSiblingVertexEdited,
+      kSiblingSortSkipped,
+      kCycleEdgeRemoved,
+      kForestNotPublished,
+      kConflictStageSkipped,
+      kTrivialEvent,
+      kLazyTreeBuilt,
+      kLazyTreeCached,
+      kLazyTreeInvalidated,
+      kSiblingMatched,
+      kNCounters
+    };
+
+    /// Default constructor
+    ManagerStats() { _enabled = true; Reset(); }
+
+    /// Default destructor
+    virtual ~ManagerStats(){}
+
+    /// Clear all timers, counters and histograms
+    void Reset();
+
+    /// Add the content of another stats object (e.g. from another thread)
+    void Merge(const ManagerStats& other);
+
+    /// Enable/disable stats collection
+    void SetEnabled(bool on) { _enabled = on; }
+    bool Enabled() const { return _enabled; }
+
+    /// Increment a counter
+    void Count(Counter_t c, uint64_t n=1) { if (_enabled) _counters[c] += n; }
+
+    /// Record the time spent in one call to a phase
+    void AddTime(Phase_t p, uint64_t ns);
+
+    /// Getters
+    uint64_t Counter(Counter_t c) const { return _counters[c]; }
+    uint64_t PhaseCalls(Phase_t p) const { return _calls[p]; }
+    uint64_t PhaseTime(Phase_t p) const { return _time[p]; }
+    const LatencyHistogram& Histogram(Phase_t p) const { return _hist[p]; }
+
+    /// Names, for printing
+    static const char* PhaseName(Phase_t p);
+    static const char* CounterName(Counter_t c);
+
+    /// Print a summary
+    void Print(std::ostream& out=std::cout) const;
+
+    /// Probe called on the thread running a phase when the phase
+    /// starts (enter = true) and when it ends, whether or not stats
+    /// are enabled. Phases nest (e.g. Prune inside ResolveConflicts).
+    /// Process-wide: set it before starting threads that use Managers.
+    /// nullptr (default): no probe
+    typedef void (*PhaseProbe_t)(Phase_t p, bool enter);
+    static void SetPhaseProbe(PhaseProbe_t probe) { _probe = probe; }
+    static PhaseProbe_t GetPhaseProbe() { return _probe; }
+
+    /**
+       \class geotree::ManagerStats::ScopedTimer
+       Times the enclosing scope and adds the result
+       to a phase when going out of scope
+    */
+    class ScopedTimer{
+    public:
+      ScopedTimer(ManagerStats& stats, Phase_t p)
+	: _stats(stats), _phase(p)
+      {
+	if (_probe) _probe(_phase,true);
+	if (_stats._enabled) _start = std::chrono::steady_clock::now();
+      }
+      ~ScopedTimer()
+      {
+	if (_stats._enabled)
+	  _stats.AddTime(_phase,std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now()-_start).count());
+	if (_probe) _probe(_phase,false);
+      }
+    private:
+      ManagerStats& _stats;
+      Phase_t _phase;
+      std::chrono::steady_clock::time_point _start;
+    };
+
+  private:
+
+    static PhaseProbe_t _probe;
+
+    bool _enabled;
+
+    uint64_t _counters[kNCounters];
+    uint64_t _calls[kNPhases];
+    uint64_t _time[kNPhases];
+    LatencyHistogram _hist[kNPhases];
+
+  };
+}
+
+#endif
+/** @} */ // end of doxygen group
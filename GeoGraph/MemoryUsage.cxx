@@ -0,0 +1,21 @@
+#ifndef MEMORYUSAGE_CXX
+#define MEMORYUSAGE_CXX
+
+#include "MemoryUsage.h"
+
+namespace geotree{
+
+  void MemoryUsage_t::Print(std::ostream& out) const {
+
+    out << "memory [bytes] nodes: " << nodes
+	<< "  correlations: " << correlations
+	<< "  tree: " << tree
+	<< "  scratch: " << scratch
+	<< "  total: " << Total() << std::endl;
+
+    return;
+  }
+
+}
+
+#endif
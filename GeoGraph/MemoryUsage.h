@@ -0,0 +1,64 @@
+/**
+ * \file MemoryUsage.h
+ *
+ * \ingroup GeoTree
+ *
+ * \brief Class def header for a class geotree::MemoryUsage_t
+ *
+ * @author david caratelli
+ */
+
+/** \addtogroup GeoTree
+    Estimated memory held by a Manager, in bytes.
+    Sizes are computed from the capacity of the containers
+    (not their size) plus a fixed per-element overhead for
+    node-based containers (std::map / std::unordered_map),
+    so that they reflect what the allocator actually handed out
+    up to malloc rounding.
+    @{*/
+#ifndef MEMORYUSAGE_H
+#define MEMORYUSAGE_H
+
+#include <cstddef>
+#include <iostream>
+
+namespace geotree{
+
+  /**
+     \class geotree::MemoryUsage_t
+     Memory report broken down by what the memory is used for
+  */
+  struct MemoryUsage_t{
+
+    /// Node objects and ID bookkeeping (node vector, ID list, ID -> index map)
+    size_t nodes;
+    /// per-node correlation storage and the vertex table
+    size_t correlations;
+    /// tree structure: children lists and head nodes
+    size_t tree;
+    /// scratch space of the conflict-resolution algorithms
+    size_t scratch;
+
+    MemoryUsage_t() : nodes(0), correlations(0), tree(0), scratch(0) {}
+
+    /// Sum of all categories
+    size_t Total() const { return nodes + correlations + tree + scratch; }
+
+    /// Print a one-line summary
+    void Print(std::ostream& out) const;
+
+    /// Per-entry allocation overhead of std::map (color + 3 links)
+    static const size_t kMapNodeOverhead = 4*sizeof(void*);
+
+    /// Per-entry allocation overhead of std::unordered_map (next link)
+    static const size_t kHashNodeOverhead = sizeof(void*);
+
+    /// Control block of a std::shared_ptr object (vptr + counts)
+    static const size_t kSharedOverhead = 2*sizeof(void*);
+
+  };
+
+}
+
+#endif
+/** @} */ // end of doxygen group
@@ -2,81 +2,152 @@
 #define NODE_CXX
 
 #include "Node.h"
+#include <algorithm>
 
 namespace geotree{
 
+  Status_t Node::tryAddCorrelation(const NodeID_t id, const double score,
+				   const VertexID_t vtx,
+				   const geotree::RelationType_t type) {
+
+    // if correlation exists then report it
+    if (this->isCorrelated(id) == true)
+      return kCorrelationExists;
+
+    GEOTREE_DEBUG(msg::kNode, "\tThis node: " << this->ID()
+		  << "\tCorrelation: " << id << "\tVtx: " << vtx << "\tScore: " << score << "\tType: " << type);
+    insertCorrelation(CorrelationEntry(id,score,vtx,type));
+
+    return kSuccess;
+  }
+
+
+  Status_t Node::tryEditCorrelation(const NodeID_t id, const double score,
+				    const VertexID_t vtx,
+				    const geotree::RelationType_t type) {
+
+    // this function should be called only if correlation exists
+    // and needs to be edited
+    size_t const i = locate(id);
+    if ( i == _corr.size() )
+      return kCorrelationNotFound;
+
+    GEOTREE_DEBUG(msg::kNode, "This node: " << this->ID()
+		  << "\tCorrelation: " << id << "\tVtx: " << vtx << "\tScore: " << score << "\tType: " << type);
+    editAt(i,score,vtx,type);
+
+    return kSuccess;
+  }
+
+
+  void Node::editAt(size_t i, const double score,
+		    const VertexID_t vtx,
+		    const geotree::RelationType_t type){
+
+    GEOTREE_CHECK(i < _corr.size(), "Node::editAt: no correlation at this position!");
+
+    if (_corr[i].Relation() == type){
+      _corr[i]._score = (Score_t)score;
+      _corr[i]._vtx   = vtx;
+      return;
+    }
+    // relation changes: move to the right group
+    NodeID_t const id = _corr[i].ID();
+    eraseAt(i);
+    insertCorrelation(CorrelationEntry(id,score,vtx,type));
+
+    return;
+  }
+
+
+  Status_t Node::tryEditCorrelation(const NodeID_t id, const double score)
+  {
+
+    size_t const i = locate(id);
+    if ( i == _corr.size() )
+      return kCorrelationNotFound;
+
+    GEOTREE_DEBUG(msg::kNode, "\tThis node: " << this->ID()
+		  << "\tCorrelation: " << id << "\t new Score: " << score);
+    _corr[i]._score = (Score_t)score;
+
+    return kSuccess;
+  }
+
+
+  Status_t Node::tryEditVertex(const NodeID_t id, const VertexID_t vtx)
+  {
+
+    size_t const i = locate(id);
+    if ( i == _corr.size() )
+      return kCorrelationNotFound;
+
+    GEOTREE_DEBUG(msg::kNode, "\tThis node: " << this->ID()
+		  << "\tCorrelation: " << id << "\t new vertex: " << vtx);
+    _corr[i]._vtx = vtx;
+
+    return kSuccess;
+  }
+
+
+  Status_t Node::tryEditCorrelation(const NodeID_t id,
+				    const geotree::RelationType_t type) {
+
+    size_t const i = locate(id);
+    if ( i == _corr.size() )
+      return kCorrelationNotFound;
+
+    GEOTREE_DEBUG(msg::kNode, "\tThis node: " << this->ID()
+		  << "\tCorrelation: " << id << "\tType: " << type);
+    if (_corr[i].Relation() == type)
+      return kSuccess;
+    // relation changes: move to the right group
+    CorrelationEntry entry = _corr[i];
+    entry._type = (StoredRelation_t)type;
+    eraseAt(i);
+    insertCorrelation(entry);
+
+    return kSuccess;
+  }
+
+
   void Node::addCorrelation(const NodeID_t id, const double score,
-			    const ::geoalgo::Point_t& vtx,
+			    const VertexID_t vtx,
 			    const geotree::RelationType_t type){
 
-    // if correlation exists then return exception!
-    if (this->isCorrelated(id) == true)
+    if (tryAddCorrelation(id,score,vtx,type) != kSuccess)
       throw ::geoalgo::GeoAlgoException("Error: Adding correlation that already exists!");
-    
-    if (_verbose){
-      std::cout << "\tThis node: " << this->ID()
-		<< "\tCorrelation: " << id << "\tVtx: " << vtx << "\tScore: " << score << "\tType: " << type << std::endl;
-    }
-    ::geotree::Correlation thisCorr(score,vtx,type);
-    _corr[id] = thisCorr;
 
     return;
   }
 
 
   void Node::editCorrelation(const NodeID_t id, const double score,
-			     const ::geoalgo::Point_t& vtx,
+			     const VertexID_t vtx,
 			     const geotree::RelationType_t type){
 
-    // if correlation between these nodes not found, raise exception
-    // this function should be called only if correlation exists
-    // and needs to be edited
-    if ( _corr.find(id) == _corr.end() )
-      throw ::geoalgo::GeoAlgoException("Error: editing correlation that does not exist!");      
-
-    if (_verbose){
-      std::cout << "This node: " << this->ID()
-		<< "\tCorrelation: " << id << "\tVtx: " << vtx << "\tScore: " << score << "\tType: " << type << std::endl;
-    }
-    _corr[id].EditCorrelation(score,vtx,type);
+    if (tryEditCorrelation(id,score,vtx,type) != kSuccess)
+      throw ::geoalgo::GeoAlgoException("Error: editing correlation that does not exist!");
 
     return;
   }
 
-  
+
   void Node::editCorrelation(const NodeID_t id, const double score)
   {
-    
-    // if correlation between these nodes not found, raise exception
-    // this function should be called only if correlation exists
-    // and needs to be edited
-    if ( _corr.find(id) == _corr.end() )
-      throw ::geoalgo::GeoAlgoException("Error: editing correlation that does not exist!");      
 
-    if (_verbose){
-      std::cout << "\tThis node: " << this->ID()
-		<< "\tCorrelation: " << id << "\t new Score: " << score << std::endl;
-    }
-    _corr[id].EditCorrelation(score);
+    if (tryEditCorrelation(id,score) != kSuccess)
+      throw ::geoalgo::GeoAlgoException("Error: editing correlation that does not exist!");
 
     return;
   }
 
 
-  void Node::editCorrelation(const NodeID_t id, const ::geoalgo::Point_t& vtx)
+  void Node::editVertex(const NodeID_t id, const VertexID_t vtx)
   {
-    
-    // if correlation between these nodes not found, raise exception
-    // this function should be called only if correlation exists
-    // and needs to be edited
-    if ( _corr.find(id) == _corr.end() )
-      throw ::geoalgo::GeoAlgoException("Error: editing correlation that does not exist!");      
 
-    if (_verbose){
-      std::cout << "\tThis node: " << this->ID()
-		<< "\tCorrelation: " << id << "\t new vertex: " << vtx << std::endl;
-    }
-    _corr[id].EditCorrelation(vtx);
+    if (tryEditVertex(id,vtx) != kSuccess)
+      throw ::geoalgo::GeoAlgoException("Error: editing correlation that does not exist!");
 
     return;
   }
@@ -85,108 +156,164 @@ namespace geotree{
   void Node::editCorrelation(const NodeID_t id,
 			     const geotree::RelationType_t type){
 
-    // if correlation between these nodes not found, raise exception
-    // this function should be called only if correlation exists
-    // and needs to be edited
-    if ( _corr.find(id) == _corr.end() )
-      throw ::geoalgo::GeoAlgoException("Error: editing correlation that does not exist!");      
-
-    if (_verbose){
-      std::cout << "\tThis node: " << this->ID()
-		<< "\tCorrelation: " << id << "\tType: " << type << std::endl;
-    }
-    _corr[id].EditCorrelation(type);
+    if (tryEditCorrelation(id,type) != kSuccess)
+      throw ::geoalgo::GeoAlgoException("Error: editing correlation that does not exist!");
 
     return;
   }
 
   /// Erase a correlated element
   void Node::eraseCorrelation(const NodeID_t node){
-    
-    if (_verbose){
-      std::cout << "\tThis node: " << this->ID()
-		<< "\tRemoving Correlation with: " << node << std::endl;
+
+    GEOTREE_DEBUG(msg::kNode, "\tThis node: " << this->ID()
+		  << "\tRemoving Correlation with: " << node);
+
+    size_t const i = locate(node);
+    if (i < _corr.size())
+      eraseAt(i);
+
+    return;
+  }
+
+  const CorrelationEntry* Node::findCorrelation(NodeID_t node) const noexcept
+  {
+
+    size_t const i = locate(node);
+    if (i == _corr.size())
+      return nullptr;
+
+    return &(_corr[i]);
+  }
+
+
+  size_t Node::locate(NodeID_t id) const noexcept
+  {
+
+    // binary search by ID within each relation group
+    for (size_t r=0; r <= ::geotree::RelationType_t::kUnknown; r++){
+      auto const begin = _corr.begin() + _group[r];
+      auto const end   = _corr.begin() + _group[r+1];
+      auto const it = std::lower_bound(begin,end,id,
+				       [](const CorrelationEntry& c, NodeID_t n) { return c.ID() < n; });
+      if ( (it != end) and (it->ID() == id) )
+	return (size_t)(it - _corr.begin());
     }
-    
-    _corr.erase(node);
+
+    return _corr.size();
+  }
+
+
+  void Node::insertCorrelation(const CorrelationEntry& entry)
+  {
+
+    GEOTREE_CHECK(locate(entry.ID()) == _corr.size(), "Node::insertCorrelation: correlation exists!");
+
+    size_t const r = entry.Relation();
+    auto const begin = _corr.begin() + _group[r];
+    auto const end   = _corr.begin() + _group[r+1];
+    auto const it = std::lower_bound(begin,end,entry.ID(),
+				     [](const CorrelationEntry& c, NodeID_t n) { return c.ID() < n; });
+    _corr.insert(it,entry);
+    for (size_t g=r+1; g <= ::geotree::RelationType_t::kUnknown+1; g++)
+      _group[g] += 1;
+
+    return;
+  }
+
+
+  void Node::eraseAt(size_t i)
+  {
+
+    GEOTREE_CHECK(i < _corr.size(), "Node::eraseAt: no correlation at this position!");
+
+    size_t const r = _corr[i].Relation();
+    _corr.erase(_corr.begin()+i);
+    for (size_t g=r+1; g <= ::geotree::RelationType_t::kUnknown+1; g++)
+      _group[g] -= 1;
 
     return;
   }
 
-  double Node::getScore(NodeID_t node)
+
+  void Node::resetGroups() noexcept
+  {
+
+    // entries stay sorted by relation: count them
+    size_t count[::geotree::RelationType_t::kUnknown+1] = {};
+    for (auto const& c : _corr)
+      count[c.Relation()] += 1;
+    _group[0] = 0;
+    for (size_t r=0; r <= ::geotree::RelationType_t::kUnknown; r++)
+      _group[r+1] = _group[r] + count[r];
+
+    return;
+  }
+
+  double Node::getScore(NodeID_t node) const
   {
 
-    if (_corr.find(node) == _corr.end()){
+    auto corr = findCorrelation(node);
+    if (corr == nullptr)
       throw ::geoalgo::GeoAlgoException("Trying to get correlation score for a correlation that does not exist");
-      return -1;
-    }
-    //return _corrScores[node];
-    return _corr[node].Score();
+
+    return corr->Score();
   }
 
-  ::geoalgo::Point_t Node::getVtx(NodeID_t node)
+  VertexID_t Node::getVtxID(NodeID_t node) const
   {
 
-    if (_corr.find(node) == _corr.end()){
+    auto corr = findCorrelation(node);
+    if (corr == nullptr)
       throw ::geoalgo::GeoAlgoException("Trying to get correlation vertex for a correlation that does not exist");
-      return ::geoalgo::Point_t();
-    }
-    //return _corrScores[node];
-    return _corr[node].Vtx();
+
+    return corr->VtxID();
   }
 
-  ::geotree::RelationType_t Node::getRelation(NodeID_t node)
+  ::geotree::RelationType_t Node::getRelation(NodeID_t node) const
   {
 
-    if (_corr.find(node) == _corr.end()){
+    auto corr = findCorrelation(node);
+    if (corr == nullptr)
       throw ::geoalgo::GeoAlgoException("Trying to get correlation type for a correlation that does not exist");
-      return ::geotree::RelationType_t::kUnknown;
-    }
-    //return _corrScores[node];
-    return _corr[node].Relation();
+
+    return corr->Relation();
   }
 
   /// check if a node is primary (has no parent or sibling)
   bool Node::isPrimary() const
   {
 
-    if (_verbose) { std::cout << "\tchecking if node is primary..."; }
-    std::map<NodeID_t, geotree::Correlation>::const_iterator it;
-    for (it = _corr.begin(); it != _corr.end(); it++){
-      if ( ((it->second).Relation() == geotree::RelationType_t::kParent) or
-	   ((it->second).Relation() == geotree::RelationType_t::kSibling) ){
-	if (_verbose) { std::cout << "\tNot primary" << std::endl; }
-	return false;
-      }
-    }
-    
-    if (_verbose) { std::cout << "\tPrimary!" << std::endl; }
-    return true;
+    return ( parents().empty() and siblings().empty() );
+  }
+
+
+  /// number of parents
+  size_t Node::nParents() const noexcept
+  {
+
+    return parents().size();
   }
 
-  
+
+  /// number of siblings
+  size_t Node::nSiblings() const noexcept
+  {
+
+    return siblings().size();
+  }
+
+
   /// check if a node has a potential conflict (has parent & sibling)
   bool Node::hasConflict() const
   {
 
-    int parents  = 0;
-    int siblings = 0;
-
-    std::map<NodeID_t, geotree::Correlation>::const_iterator it;
-    for (it = _corr.begin(); it != _corr.end(); it++){
-      if ((it->second).Relation() == geotree::RelationType_t::kParent){
-	if (_verbose) { std::cout << "\tparent! ID: " << it->first << std::endl; }
-	parents += 1;
-      }
-      if ((it->second).Relation() == geotree::RelationType_t::kSibling)
-	siblings += 1;
-    }
-    
+    size_t const nparents = nParents();
+
     // if more than 1 parent something went wrong!
-    if (parents > 1)
+    if (nparents > 1)
       throw ::geoalgo::GeoAlgoException("hasConflict: Node has more than 1 parent! something went wrong!");
 
-    if ( (parents > 0) and (siblings > 0) )
+    if ( (nparents > 0) and (nSiblings() > 0) )
       return true;
 
     return false;
@@ -196,14 +323,8 @@ namespace geotree{
   /// check if node has a parent
   bool Node::hasParent() const
   {
-    
-    int parents = 0;
 
-    std::map<NodeID_t, geotree::Correlation>::const_iterator it;
-    for (it = _corr.begin(); it != _corr.end(); it++){
-      if ((it->second).Relation() == geotree::RelationType_t::kParent)
-	parents += 1;
-    }
+    size_t parents = nParents();
 
     if (parents > 1)
       throw ::geoalgo::GeoAlgoException("hasParent: Node has more than 1 parent! something went wrong!");
@@ -215,25 +336,35 @@ namespace geotree{
   }
 
 
+  /// get parent ID (no exception)
+  Status_t Node::tryGetParent(NodeID_t& parent) const noexcept
+  {
+
+    auto const p = parents();
+
+    if (p.size() > 1)
+      return kMultipleParents;
+
+    if (p.empty())
+      return kNoParent;
+
+    parent = p[0].ID();
+
+    return kSuccess;
+  }
+
+
   /// get parent ID
   NodeID_t Node::getParent() const
   {
-    
+
     NodeID_t parent = -1;
-    int parents = 0;
-
-    std::map<NodeID_t, geotree::Correlation>::const_iterator it;
-    for (it = _corr.begin(); it != _corr.end(); it++){
-      if ((it->second).Relation() == geotree::RelationType_t::kParent){
-	parent = it->first;
-	parents += 1;
-      }
-    }
+    Status_t status = tryGetParent(parent);
 
-    if (parents > 1)
+    if (status == kMultipleParents)
       throw ::geoalgo::GeoAlgoException("getParent: Node has more than 1 parent! something went wrong!");
 
-    if (parents == 0)
+    if (status == kNoParent)
       throw ::geoalgo::GeoAlgoException("No parent when one expected! something went wrong!");
 
     return parent;
@@ -243,51 +374,58 @@ namespace geotree{
   /// check if node has a parent
   bool Node::hasSiblings() const
   {
-    
-    int siblings = 0;
-
-    std::map<NodeID_t, geotree::Correlation>::const_iterator it;
-    for (it = _corr.begin(); it != _corr.end(); it++){
-      if ((it->second).Relation() == geotree::RelationType_t::kSibling)
-	siblings += 1;
-    }
-
-    if (siblings >= 1)
-      return true;
 
-    return false;
+    return (siblings().empty() == false);
   }
 
 
   /// get sibling IDs
   std::vector<NodeID_t> Node::getSiblings() const
   {
-    
-    std::vector<NodeID_t> siblings;
 
-    std::map<NodeID_t, geotree::Correlation>::const_iterator it;
-    for (it = _corr.begin(); it != _corr.end(); it++){
-      if ((it->second).Relation() == geotree::RelationType_t::kSibling)
-	siblings.push_back(it->first);
-    }
+    IDList_t buffer;
+    getSiblings(buffer);
 
-    if (siblings.size() == 0)
+    if (buffer.size() == 0)
       throw ::geoalgo::GeoAlgoException("Trying to get siblings expecting >=1 but got 0! something went wrong!");
-    
-    return siblings;
+
+    return std::vector<NodeID_t>(buffer.begin(),buffer.end());
+  }
+
+  /// get sibling IDs into the caller's buffer
+  void Node::getSiblings(IDList_t& siblings) const
+  {
+
+    auto const s = this->siblings();
+    siblings.clear();
+    siblings.reserve(s.size());
+    for (auto const& c : s)
+      siblings.push_back(c.ID());
+
+    return;
+  }
+
+  /// get parent IDs into the caller's buffer
+  void Node::getParents(IDList_t& parents) const
+  {
+
+    auto const p = this->parents();
+    parents.clear();
+    parents.reserve(p.size());
+    for (auto const& c : p)
+      parents.push_back(c.ID());
+
+    return;
   }
 
   // Check if node is correlated with another
-  bool Node::isCorrelated(NodeID_t id){
-    
-    if (_corr.find(id) != _corr.end())
-      return true;
+  bool Node::isCorrelated(NodeID_t id) const noexcept {
 
-    return false;
+    return (locate(id) != _corr.size());
   }
 
   /// check if a specific relation type is prohibited
-  bool Node::isProhibited(::geotree::RelationType_t rel){
+  bool Node::isProhibited(::geotree::RelationType_t rel) const noexcept {
 
     for (size_t i=0; i < _prohibits.size(); i++){
       if (_prohibits[i] == rel)
@@ -297,6 +435,19 @@ namespace geotree{
     return false;
   }
 
+  /// heap memory held by this node
+  void Node::addMemoryUsage(MemoryUsage_t& usage) const {
+
+    usage.nodes += _prohibits.capacity()*sizeof(::geotree::RelationType_t);
+    if (_child_id_v.onHeap())
+      usage.tree += _child_id_v.capacity()*sizeof(NodeID_t);
+    usage.nodes += _vtx.capacity()*sizeof(double);
+
+    usage.correlations += _corr.capacity()*sizeof(CorrelationEntry);
+
+    return;
+  }
+
 }
 
 #endif
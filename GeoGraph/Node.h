@@ -15,18 +15,104 @@
 #define NODE_H
 
 #include "Correlation.h"
-#include <map>
+#include "Logger.h"
+#include "MemoryUsage.h"
+#include "Status.h"
+#include "SmallVector.h"
+#include "VertexTable.h"
+#include "CompactStorage.h"
+#include "Invariants.h"
+#include <iterator>
+#include <vector>
 #include <string>
 
 typedef size_t NodeID_t;
 
+namespace geotree{
+  /// list of node IDs (children, siblings, parents): no allocation up to 4 entries
+  typedef SmallVector<NodeID_t,4> IDList_t;
+}
+
 
 
 namespace geotree{
 
   class Manager;
+  class Node;
   class NodeCollection;
 
+  /**
+     \class geotree::CorrelationEntry
+     A correlation as stored by a node: the ID of the node
+     it points to, score, relation type and the ID of its
+     vertex in the event's VertexTable
+     (see NodeCollection::Vertex for the point).
+     Stored in reduced precision with GEOTREE_COMPACT
+     (see CompactStorage.h)
+  */
+  class CorrelationEntry{
+
+    friend class ::geotree::Node;
+
+  public:
+
+    CorrelationEntry()
+      : _id(0), _score(0.), _vtx(0), _type(::geotree::RelationType_t::kUnknown) {}
+
+    CorrelationEntry(NodeID_t id, double score, VertexID_t vtx, ::geotree::RelationType_t type)
+      : _id((StoredNodeID_t)id), _score((Score_t)score), _vtx(vtx), _type((StoredRelation_t)type) {}
+
+    /// ID of the correlated node
+    NodeID_t ID() const noexcept { return _id; }
+
+    /// Getters
+    double Score() const noexcept { return _score; }
+    VertexID_t VtxID() const noexcept { return _vtx; }
+    ::geotree::RelationType_t Relation() const noexcept { return (::geotree::RelationType_t)_type; }
+
+  private:
+
+    StoredNodeID_t _id;
+    Score_t _score;
+    VertexID_t _vtx;
+    StoredRelation_t _type;
+
+  };
+
+  /**
+     \class geotree::RelationRange
+     Range over the correlations of a node that share one
+     relation type (or over all of them). A node keeps its
+     correlations grouped by relation type, so the range is
+     a contiguous slice of its storage: nothing is copied or
+     filtered. Entries give ID(), Score(), VtxID(), Relation().
+     The range is invalidated by any change to the node's
+     correlations.
+  */
+  class RelationRange{
+
+  public:
+
+    typedef const CorrelationEntry* const_iterator;
+
+    RelationRange(const_iterator begin, const_iterator end) noexcept
+      : _begin(begin), _end(end) {}
+
+    const_iterator begin() const noexcept { return _begin; }
+    const_iterator end()   const noexcept { return _end; }
+
+    bool   empty() const noexcept { return (_begin == _end); }
+    size_t size()  const noexcept { return (size_t)(_end - _begin); }
+
+    const CorrelationEntry& operator[](size_t i) const noexcept { return _begin[i]; }
+
+  private:
+
+    const_iterator _begin;
+    const_iterator _end;
+
+  };
+
   /**
      \class geotree::Node
      User defined class geograph::Node
@@ -47,12 +133,12 @@ namespace geotree{
 
     // Constructors are private -> only accessed by Manager friend class
     /// Default constructor
-    Node(){}
+    Node() : _group() {}
 
     //Node(const Node& orig) : Node() {std::cout<<"copy ctor"<<std::endl;}
 
     /// Constructor
-    Node(size_t n) { _node_id = n; _verbose = false; }
+    Node(size_t n) : _node_id(n), _group() {}
     
   public:
 
@@ -66,22 +152,34 @@ namespace geotree{
     NodeID_t parentID() const { return _parent_id; }
 
     /// getter for children
-    const std::vector<NodeID_t>& childrenID() const { return _child_id_v; }
+    const IDList_t& childrenID() const { return _child_id_v; }
 
-    //*********************************
-    // 3 maps for correlation is stupid
-    // Change this to a struct!!!!!!!!!
-    //*********************************
-    
-    /// getter for correlations
-    const std::map<NodeID_t, ::geotree::Correlation>& getCorrelations() const { return _corr; }
+    /// all correlations (grouped by relation type, by node ID within a group)
+    RelationRange correlations() const noexcept { return RelationRange(_corr.data(),_corr.data()+_corr.size()); }
+
+    /// correlations of one relation type
+    RelationRange relation(::geotree::RelationType_t type) const noexcept
+    { return RelationRange(_corr.data()+_group[type],_corr.data()+_group[type+1]); }
+
+    /// nodes that are parents of this one (empty range if there are none)
+    RelationRange parents() const noexcept { return relation(::geotree::RelationType_t::kParent); }
+
+    /// nodes that are children of this one through a correlation
+    /// (not the tree children, see childrenID())
+    RelationRange children() const noexcept { return relation(::geotree::RelationType_t::kChild); }
+
+    /// nodes that are siblings of this one (empty range if there are none)
+    RelationRange siblings() const noexcept { return relation(::geotree::RelationType_t::kSibling); }
 
     /// get score (if corr exists)
-    double getScore(NodeID_t node);
-    /// get vertex (if corr exists)
-    ::geoalgo::Point_t getVtx(NodeID_t node);
+    double getScore(NodeID_t node) const;
+    /// get vertex ID (if corr exists)
+    VertexID_t getVtxID(NodeID_t node) const;
     /// get relation type (if corr exists)
-    ::geotree::RelationType_t getRelation(NodeID_t node);
+    ::geotree::RelationType_t getRelation(NodeID_t node) const;
+
+    /// correlation with another node. nullptr if they are not correlated
+    const CorrelationEntry* findCorrelation(NodeID_t node) const noexcept;
     
     /// erase elements for correlation maps
     void eraseCorrelation(const NodeID_t node);
@@ -97,17 +195,26 @@ namespace geotree{
 
     std::vector<NodeID_t> getSiblings() const;
 
+    /// fill a buffer owned by the caller with the sibling / parent IDs
+    /// (cleared first; no allocation for up to 4 entries)
+    void getSiblings(IDList_t& siblings) const;
+    void getParents(IDList_t& parents) const;
+
+    /// number of parents / siblings
+    size_t nParents() const noexcept;
+    size_t nSiblings() const noexcept;
+
+    /// get parent's ID: kSuccess, kNoParent or kMultipleParents
+    Status_t tryGetParent(NodeID_t& parent) const noexcept;
+
     /// Check if node is primary (has no parent or sibling)
      bool isPrimary() const;
 
     /// Check if node has a conflict (parent & sibling)
     bool hasConflict() const;
 
-    /// debug setter
-    void setVerbose(bool on) { _verbose = on; }
-
     /// Check if this node is correlated with another. Boolean return
-    bool isCorrelated(NodeID_t id);
+    bool isCorrelated(NodeID_t id) const noexcept;
 
     /// Add a prohibit relation to this node
     void addProhibit(::geotree::RelationType_t rel) { _prohibits.push_back(rel); }
@@ -116,7 +223,7 @@ namespace geotree{
     bool hasProhibit() { bool has=false; (_prohibits.size() > 0) ? has = true : has = false; return has; }
 
     /// check if a specific relation is prohibited
-    bool isProhibited(::geotree::RelationType_t rel);
+    bool isProhibited(::geotree::RelationType_t rel) const noexcept;
 
     /// Add child
     void addChild(NodeID_t id) { _child_id_v.push_back(id); }
@@ -124,43 +231,106 @@ namespace geotree{
     /// Set Parent
     void setParent(NodeID_t id) { _parent_id = id; }
 
+    /// erase all correlations for which pred(otherID, correlation) is true,
+    /// in one pass over the node's correlations. Returns the number erased
+    template <class Pred>
+    size_t eraseCorrelationsIf(Pred pred)
+    {
+      size_t kept = 0;
+      for (size_t i=0; i < _corr.size(); i++){
+	if (pred(_corr[i].ID(),_corr[i]))
+	  continue;
+	if (kept != i) _corr[kept] = _corr[i];
+	kept += 1;
+      }
+      size_t const erased = _corr.size() - kept;
+      _corr.resize(kept);
+      if (erased > 0) resetGroups();
+      return erased;
+    }
+
+    /// presize correlation storage for n entries
+    void reserveCorrelations(size_t n) { _corr.reserve(n); }
+
+    /// add the heap memory held by this node to a report
+    /// (the Node object itself is accounted for by NodeCollection)
+    void addMemoryUsage(MemoryUsage_t& usage) const;
+
     /// Add a correlated node and the associated score & vtx info
+    /// (vertices are IDs in the event's VertexTable)
     void addCorrelation(const NodeID_t id, const double score,
-    			const ::geoalgo::Point_t& vtx,
+			const VertexID_t vtx,
 			const geotree::RelationType_t type);
 
     /// edit a correlated node's information (score, vtx, type)
     void editCorrelation(const NodeID_t id, const double score,
-			 const ::geoalgo::Point_t& vtx,
+			 const VertexID_t vtx,
 			 const geotree::RelationType_t type);
 
     /// edit a correlated node's information (score)
     void editCorrelation(const NodeID_t id, const double score);
 
     /// edit a correlated node's information (vtx)
-    void editCorrelation(const NodeID_t id,
-			 const ::geoalgo::Point_t& vtx);
+    void editVertex(const NodeID_t id, const VertexID_t vtx);
 
     /// edit a correlated node's information (type)
     void editCorrelation(const NodeID_t id,
 			 const geotree::RelationType_t type);
 
+    /// versions of add/editCorrelation that
+    /// return kCorrelationExists / kCorrelationNotFound on failure
+    /// (they allocate: std::bad_alloc is not caught)
+    Status_t tryAddCorrelation(const NodeID_t id, const double score,
+			       const VertexID_t vtx,
+			       const geotree::RelationType_t type);
+    Status_t tryEditCorrelation(const NodeID_t id, const double score,
+				const VertexID_t vtx,
+				const geotree::RelationType_t type);
+    Status_t tryEditCorrelation(const NodeID_t id, const double score);
+    Status_t tryEditVertex(const NodeID_t id, const VertexID_t vtx);
+    Status_t tryEditCorrelation(const NodeID_t id,
+				const geotree::RelationType_t type);
+
+    /// trusted mutations (see Invariants.h): the caller found the
+    /// entry with locate() and established that the change is
+    /// valid. Preconditions are only checked in GEOTREE_CHECKED builds
+
+    /// position of the correlation with a node (nCorrelations() if none)
+    size_t locate(NodeID_t id) const noexcept;
+
+    /// number of correlations / the correlation at a position
+    size_t nCorrelations() const noexcept { return _corr.size(); }
+    const CorrelationEntry& correlationAt(size_t i) const noexcept { return _corr[i]; }
+
+    /// edit the correlation at a position (score, vtx, type)
+    void editAt(size_t i, const double score,
+		const VertexID_t vtx,
+		const geotree::RelationType_t type);
+
+    /// insert a correlation with a node not correlated yet,
+    /// keeping the grouping / remove the entry at a position
+    void insertCorrelation(const CorrelationEntry& entry);
+    void eraseAt(size_t i);
+
   private:
-    
-    // verbosity flag
-    bool _verbose;
+
+    /// recompute the group boundaries from the entries
+    void resetGroups() noexcept;
     
     // unique ID that identifies this node
     NodeID_t _node_id;
     // ID linking to parent node
     NodeID_t _parent_id;
     // vector listing IDs of children nodes
-    std::vector<NodeID_t> _child_id_v;
+    IDList_t _child_id_v;
     // vertex
     geoalgo::Point_t _vtx;
     // each node can have a list of "correlated" nodes
-    // each correlated node comes with a score
-    std::map<size_t, ::geotree::Correlation> _corr;
+    // each correlated node comes with a score.
+    // Sorted by relation type, then by node ID: the correlations
+    // of relation type r are [_group[r], _group[r+1])
+    std::vector<CorrelationEntry> _corr;
+    unsigned int _group[::geotree::RelationType_t::kUnknown+2];
 
     // keep track of the prohibits for this node
     // prohibits is a list of relations that this
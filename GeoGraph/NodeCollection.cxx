@@ -6,20 +6,14 @@
 namespace geotree{
 
   // is the node contained in the vector of nodes?
-  bool NodeCollection::NodeExists(const size_t ID){
+  bool NodeCollection::NodeExists(const size_t ID) const noexcept {
 
-    // check that node has not been added
-    for (size_t i=0; i < _nodes.size(); i++){
-      if (_nodes[i].ID() == ID)
-	return true;
-    }
-    
-    return false;
+    return (_n_map->find(ID) != _n_map->end());
   }
 
 
   // has the node been added to the Tree-structure?
-  bool NodeCollection::NodeAdded(const NodeID_t ID){
+  bool NodeCollection::NodeAdded(const NodeID_t ID) const {
 
     bool found = false;
     
@@ -38,12 +32,13 @@ namespace geotree{
 
 
   // find node as subnode of other node
-  bool NodeCollection::IsSubNode(NodeID_t search, NodeID_t top){
+  bool NodeCollection::IsSubNode(NodeID_t search, NodeID_t top) const {
 
     bool found = false;
 
-    for (size_t i=0; i < _nodes[_n_map[top]].childrenID().size(); i++){
-      NodeID_t thisChildID = _nodes[_n_map[top]].childrenID()[i];
+    auto const& children = FindNode(top)->childrenID();
+    for (size_t i=0; i < children.size(); i++){
+      NodeID_t thisChildID = children[i];
       if (thisChildID == search){
 	found = true;
 	return found;
@@ -91,9 +86,9 @@ namespace geotree{
       std::cout << " " <<  std::setfill('0') << std::setw(3) << ids_sorted[n] << " |";
       // loop over all nodes. if correlated print out corr type
       for (size_t m=0; m < nnodes; m++){
-	if (_nodes[_n_map[ids_sorted[n]]].isCorrelated(ids_sorted[m]) == true){
+	if (FindNode(ids_sorted[n])->isCorrelated(ids_sorted[m]) == true){
 	  // get correlation type
-	  auto const rel = _nodes[_n_map[ids_sorted[n]]].getRelation(ids_sorted[m]);
+	  auto const rel = FindNode(ids_sorted[n])->getRelation(ids_sorted[m]);
 	  if (rel == ::geotree::RelationType_t::kSibling) { std::cout << "  S  |"; }
 	  if (rel == ::geotree::RelationType_t::kParent)  { std::cout << "  P  |"; }
 	  if (rel == ::geotree::RelationType_t::kChild)   { std::cout << "  C  |"; }
@@ -135,9 +130,9 @@ namespace geotree{
     std::cout << id << std::endl;
     // get list of children
     // this node:
-    Node thisnode = _nodes[_n_map[id]];
+    const Node& thisnode = *FindNode(id);
     // vector of children ids
-    auto const child_ids = thisnode.childrenID();
+    auto const& child_ids = thisnode.childrenID();
     for (size_t x=0; x < child_ids.size(); x++)
       Diagram(child_ids[x],gen+1);
     
@@ -151,19 +146,37 @@ namespace geotree{
     if (NodeExists(ID) == true)
       throw ::geoalgo::GeoAlgoException("Error: Adding a node with ID that already exists! ID must be unique!");      
 
+    // correlation entries store 32-bit IDs in compact mode
+    if ( kCompactStorage and ((StoredNodeID_t)ID != ID) )
+      throw ::geoalgo::GeoAlgoException(Form("Error: node ID %zu does not fit the compact correlation storage!",ID));
+
     // made it this far. no problems -> save node
-    Node thisnode(ID);
-    thisnode.setVerbose(_verbose);
+    std::shared_ptr<Node> thisnode(new Node(ID));
+    thisnode->reserveCorrelations(_corr_per_node);
     _nodes.push_back(thisnode);
     size_t idx = _nodes.size()-1;
-    _n_map[ID] = idx;
+    UnshareIndex();
+    (*_n_map)[ID] = idx;
     _IDs.push_back(ID);
-    _idx_map[idx] = ID;
+    if (ID >= _next_id)
+      _next_id = ID+1;
       
     return;
   }
 
 
+  NodeID_t NodeCollection::AddNode(){
+
+    NodeID_t const ID = _next_id;
+    if (ID == 0 and _IDs.empty() == false)
+      throw ::geoalgo::GeoAlgoException("Error: no node ID left to allocate!");
+
+    AddNode(ID);
+
+    return ID;
+  }
+
+
   void NodeCollection::AddPrimaryNode(const size_t ID){
 
     _head_node_v.emplace_back(ID);
@@ -172,22 +185,202 @@ namespace geotree{
   }
 
 
+  const Node& NodeCollection::GetNode(const NodeID_t ID) const {
+
+    const Node* node = FindNode(ID);
+    if (node == nullptr)
+      throw ::geoalgo::GeoAlgoException("Error: Node ID does not exist!");      
+
+    return *node;
+  }
+
+
   Node& NodeCollection::GetNode(const NodeID_t ID){
 
-    if (NodeExists(ID) == false)
+    Node* node = EditNode(ID);
+    if (node == nullptr)
       throw ::geoalgo::GeoAlgoException("Error: Node ID does not exist!");      
 
-    return _nodes[_n_map[ID]];
+    return *node;
+  }
+
+
+  const Node* NodeCollection::FindNode(const NodeID_t ID) const noexcept {
+
+    auto it = _n_map->find(ID);
+    if (it == _n_map->end())
+      return nullptr;
+
+    return _nodes[it->second].get();
+  }
+
+
+  Node* NodeCollection::EditNode(const NodeID_t ID){
+
+    auto it = _n_map->find(ID);
+    if (it == _n_map->end())
+      return nullptr;
+
+    return EditNodeAt(it->second);
+  }
+
+
+  Node* NodeCollection::EditNodeAt(size_t idx){
+
+    GEOTREE_CHECK(idx < _nodes.size(), "EditNodeAt: no node at this position!");
+
+    // copy on write: another snapshot still refers to this node
+    auto& node = _nodes[idx];
+    if (Owned(node) == false)
+      node = std::make_shared<Node>(*node);
+
+    return node.get();
+  }
+
+
+  size_t NodeCollection::SharedNodes() const {
+
+    size_t shared = 0;
+    for (auto const& node : _nodes)
+      if (node.use_count() > 1) shared += 1;
+
+    return shared;
+  }
+
+
+  void NodeCollection::SetGlobalVerbose(bool on){
+
+    msg::Level_t const lvl = on ? msg::kDEBUG : msg::kNORMAL;
+    Logger::SetLevel(msg::kCollection,lvl);
+    Logger::SetLevel(msg::kNode,lvl);
+
+    return;
+  }
+
+
+  void NodeCollection::Reset(){
+
+    _nodes.clear();
+    _head_node_v.clear();
+    _IDs.clear();
+    _next_id = 0;
+    // keep the index (and its buckets) only if no snapshot uses it
+    if (Owned(_n_map) == false)
+      _n_map = std::make_shared<IndexMap_t>();
+    else
+      _n_map->clear();
+    if (Owned(_vertices) == false)
+      _vertices = std::make_shared<VertexTable>();
+    else
+      _vertices->Clear();
+
+    return;
+  }
+
+
+  void NodeCollection::Extract(const NodeCollection& src, const std::vector<size_t>& positions){
+
+    Reset();
+
+    UnshareIndex();
+    for (auto const& p : positions){
+      NodeID_t const ID = src._IDs[p];
+      _nodes.push_back(src._nodes[p]);
+      (*_n_map)[ID] = _nodes.size()-1;
+      _IDs.push_back(ID);
+    }
+    _vertices = src._vertices;
+    _next_id  = src._next_id;
+
+    return;
+  }
+
+
+  VertexTable& NodeCollection::EditVertices(){
+
+    if (Owned(_vertices) == false)
+      _vertices = std::make_shared<VertexTable>(*_vertices);
+
+    return *_vertices;
+  }
+
+
+  std::map<NodeID_t, ::geotree::Correlation> NodeCollection::GetCorrelations(const NodeID_t ID) const {
+
+    const Node* node = FindNode(ID);
+    if (node == nullptr)
+      throw ::geoalgo::GeoAlgoException("Node ID not found!");
+
+    std::map<NodeID_t, ::geotree::Correlation> corrs;
+    for (auto const& c : node->correlations())
+      corrs.insert(std::make_pair(c.ID(),::geotree::Correlation(c.Score(),Vertex(c.VtxID()),c.Relation())));
+
+    return corrs;
+  }
+
+
+  void NodeCollection::UnshareIndex(){
+
+    if (Owned(_n_map) == false)
+      _n_map = std::make_shared<IndexMap_t>(*_n_map);
+
+    return;
   }
 
 
   // find node ID from position in node vector
   NodeID_t NodeCollection::FindID(size_t idx){
     
-    if (_idx_map.find(idx) == _idx_map.end())
+    if (idx >= _IDs.size())
       throw ::geoalgo::GeoAlgoException("Looking for an index that is out of bounds!");
 
-    return _idx_map[idx];
+    return _IDs[idx];
+  }
+
+
+  size_t NodeCollection::FindIndex(const NodeID_t ID) const {
+
+    auto it = _n_map->find(ID);
+    if (it == _n_map->end())
+      throw ::geoalgo::GeoAlgoException("Node ID not found!");
+
+    return it->second;
+  }
+
+
+  void NodeCollection::Reserve(size_t nodes, size_t corrPerNode){
+
+    _nodes.reserve(nodes);
+    _IDs.reserve(nodes);
+    UnshareIndex();
+    _n_map->reserve(nodes);
+    // one vertex per correlation, stored on two nodes
+    EditVertices().Reserve(nodes*corrPerNode/2);
+    _corr_per_node = corrPerNode;
+
+    return;
+  }
+
+
+  void NodeCollection::AddMemoryUsage(MemoryUsage_t& usage) const {
+
+    // shared nodes are counted in full by every collection that refers to them
+    usage.nodes += _nodes.capacity()*sizeof(std::shared_ptr<::geotree::Node>);
+    usage.nodes += _nodes.size()*(MemoryUsage_t::kSharedOverhead + sizeof(::geotree::Node));
+    usage.nodes += _IDs.capacity()*sizeof(NodeID_t);
+    usage.nodes += _n_map->bucket_count()*sizeof(void*);
+    usage.nodes += _n_map->size()*(MemoryUsage_t::kHashNodeOverhead + sizeof(std::pair<const NodeID_t,size_t>));
+
+    // deque: fixed-size chunks of 512 bytes plus the chunk map
+    size_t const perChunk = 512/sizeof(NodeID_t);
+    usage.tree += (_head_node_v.size()/perChunk + 1)*512 + 8*sizeof(void*);
+
+    for (auto const& node : _nodes)
+      node->addMemoryUsage(usage);
+
+    _vertices->AddMemoryUsage(usage);
+
+    return;
   }
 
   
@@ -14,7 +14,11 @@
 #ifndef NODECOLLECTION_H
 #define NODECOLLECTION_H
 
+#include <atomic>
 #include <deque>
+#include <map>
+#include <memory>
+#include <unordered_map>
 #include "Node.h"
 #include "GeoAlgo/GeoVector.h"
 #include <iomanip> // to pad with zeros
@@ -27,6 +31,17 @@ namespace geotree{
      User defined class geograph::NodeCollection
      Responsible for holding a collection
      of nodes and ensuring their uniqueness
+     The collection also owns the event's VertexTable: the
+     correlations stored by the nodes refer to it by VertexID_t.
+     Copies are cheap snapshots: nodes (the ID index, the vertex table)
+     are shared between copies and only duplicated when
+     one of the copies modifies them (copy-on-write).
+     Read through FindNode / const GetNode, modify through
+     EditNode / non-const GetNode.
+     Copies may be modified on different threads (a node or table
+     is modified in place only once no other copy owns it, see
+     Owned), but a collection must not be copied while it is
+     being modified.
   */
   
   class NodeCollection{
@@ -34,7 +49,11 @@ namespace geotree{
   public:
 
     /// Default constructor
-    NodeCollection(){ _verbose = false; }
+    NodeCollection()
+      : _n_map(std::make_shared<IndexMap_t>())
+      , _vertices(std::make_shared<VertexTable>())
+      , _corr_per_node(0)
+      , _next_id(0) {}
 
     // Default destructor
     virtual ~NodeCollection(){}
@@ -42,26 +61,88 @@ namespace geotree{
     /// Add a node to the internal vector of nodes
     void AddNode(const size_t ID);
 
+    /// Add a node with a new ID, larger than every ID in the
+    /// collection (O(1), never collides). Returns the ID
+    NodeID_t AddNode();
+
     /// Add a primary node
     void AddPrimaryNode(const NodeID_t ID);
 
-    /// Get a node
+    /// Get a node for reading
+    const Node& GetNode(const NodeID_t ID) const;
+
+    /// Get a node for modification (unshares it)
     Node& GetNode(const NodeID_t ID);
 
-    /// Get a list of node IDs
-    std::vector<NodeID_t> GetNodeIDs() { return _IDs; }
+    /// Get a node for reading without exceptions: nullptr if the ID does not exist
+    const Node* FindNode(const NodeID_t ID) const noexcept;
+
+    /// Get a node for modification: nullptr if the ID does not exist.
+    /// A node shared with another copy of the collection is copied
+    /// first (which may throw std::bad_alloc)
+    Node* EditNode(const NodeID_t ID);
+
+    /// Node at a position (see FindIndex) for modification (unshares it).
+    /// The position is not checked (trusted, see Invariants.h)
+    Node* EditNodeAt(size_t idx);
+
+    /// Vertex table of the event (read only)
+    const VertexTable& Vertices() const { return *_vertices; }
+
+    /// Vertex table for modification (unshares it)
+    VertexTable& EditVertices();
+
+    /// Point of a vertex ID
+    VertexPoint_t Vertex(const VertexID_t vtx) const { return _vertices->Get(vtx); }
+
+    /// Copy of the correlations of a node keyed by the other node's ID,
+    /// with their vertex points (use FindNode(ID)->correlations() to
+    /// read them in place)
+    std::map<NodeID_t, ::geotree::Correlation> GetCorrelations(const NodeID_t ID) const;
+
+    /// The vertex table itself, shared (to restore it later with LoadVertices)
+    std::shared_ptr<VertexTable> ShareVertices() const { return _vertices; }
+
+    /// Replace the vertex table with one obtained from ShareVertices
+    void LoadVertices(const std::shared_ptr<VertexTable>& vertices) { _vertices = vertices; }
+
+    /// Number of nodes shared with other copies of the collection
+    size_t SharedNodes() const;
 
-    /// Clear collection
-    void Reset() { _nodes.clear(); _n_map.clear(); _idx_map.clear(); _head_node_v.clear(); _IDs.clear(); }
+    /// Node IDs, in node order (valid until a node is added or the collection is Reset)
+    const std::vector<NodeID_t>& GetNodeIDs() const { return _IDs; }
+
+    /// Number of nodes
+    size_t NodeCount() const { return _nodes.size(); }
+
+    /// Node at a position in the node vector (see FindIndex), for reading
+    const Node& NodeAt(size_t idx) const { return *_nodes[idx]; }
+
+    /// Clear collection (capacity is kept for the next event)
+    void Reset();
+
+    /// Replace the content with the nodes at some positions of another
+    /// collection (increasing positions; the nodes must only be
+    /// correlated among themselves). Nodes and vertex table are shared
+    /// with src (copied on write); new IDs (AddNode()) continue above
+    /// the IDs of src
+    void Extract(const NodeCollection& src, const std::vector<size_t>& positions);
+
+    /// Presize for an event with this many nodes, each expected
+    /// to hold about corrPerNode correlations
+    void Reserve(size_t nodes, size_t corrPerNode);
+
+    /// Add the memory held by the collection and its nodes to a report
+    void AddMemoryUsage(MemoryUsage_t& usage) const;
 
     /// Clear the tree
     void ClearTree() { _head_node_v.clear(); }
 
     /// Check if node exists in collection. Returns boolean
-    bool NodeExists(const size_t ID);
+    bool NodeExists(const size_t ID) const noexcept;
 
     /// check if the node has been added to the tree
-    bool NodeAdded(const NodeID_t ID);
+    bool NodeAdded(const NodeID_t ID) const;
 
     /// Print correlation matrix for nodes in event
     void CorrelationMatrix();
@@ -75,20 +156,45 @@ namespace geotree{
     /// Find the NodeID from the position in the node vector
     NodeID_t FindID(size_t idx);
 
-    /// verbosity setter
-    void SetVerbose(bool on) { _verbose = on; }
+    /// Position of a node in the node vector (same order as GetNodeIDs)
+    size_t FindIndex(const NodeID_t ID) const;
+
+    /// IDs of the head nodes of the trees
+    const std::deque<NodeID_t>& GetHeadNodes() const { return _head_node_v; }
+
+    /// Process-wide verbosity of collections and nodes: debug
+    /// messages of every collection in every Manager and thread.
+    /// For one Manager use Manager::setVerbose
+    static void SetGlobalVerbose(bool on);
 
 
   private:
 
-    /// verbosity flag
-    bool _verbose;
+    typedef std::unordered_map<NodeID_t, size_t> IndexMap_t;
 
     /// Check if a node is a subnode of another node
-    bool IsSubNode(NodeID_t search, NodeID_t top);
+    bool IsSubNode(NodeID_t search, NodeID_t top) const;
+
+    /// make sure the ID index is not shared before modifying it
+    void UnshareIndex();
+
+    /// Is this collection the only owner of a shared object, so that
+    /// it may be modified in place? use_count() is a relaxed load:
+    /// on its own it does not order the modification after what
+    /// another thread did with its copy before releasing it. The
+    /// release is an atomic decrement with release semantics (as
+    /// shared_ptr needs for its deleter), so an acquire fence after
+    /// reading a count of 1 does. A stale count above 1 only costs a copy
+    template <class T>
+    static bool Owned(const std::shared_ptr<T>& p){
+      if (p.use_count() > 1)
+	return false;
+      std::atomic_thread_fence(std::memory_order_acquire);
+      return true;
+    }
     
-    /// NodeCollection of all nodes created
-    std::vector<::geotree::Node> _nodes;
+    /// NodeCollection of all nodes created (shared between snapshots)
+    std::vector< std::shared_ptr<::geotree::Node> > _nodes;
 
     /// keep track of the indices of primary nodes
     std::deque<NodeID_t> _head_node_v;
@@ -97,10 +203,18 @@ namespace geotree{
     std::vector<NodeID_t> _IDs;
 
     /// Map that goes from NodeID_t to position in node vector
-    std::map<NodeID_t, size_t> _n_map;
+    /// (position -> ID is _IDs, filled in the same order as _nodes)
+    /// shared between snapshots until a node is added
+    std::shared_ptr<IndexMap_t> _n_map;
+
+    /// vertices of the correlations (shared between snapshots until modified)
+    std::shared_ptr<VertexTable> _vertices;
+
+    /// expected correlations per node (see Reserve)
+    size_t _corr_per_node;
 
-    /// map to link position in node vector with ID
-    std::map<size_t, NodeID_t> _idx_map;
+    /// smallest ID larger than all IDs in the collection
+    NodeID_t _next_id;
 
   };
 }
@@ -0,0 +1,272 @@
+#ifndef PIPELINE_CXX
+#define PIPELINE_CXX
+
+#include "Pipeline.h"
+#include <chrono>
+#include <iomanip>
+#include <thread>
+
+namespace geotree{
+
+  typedef std::chrono::steady_clock PipelineClock_t;
+
+  static uint64_t ElapsedNs(const PipelineClock_t::time_point& start)
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(PipelineClock_t::now()-start).count();
+  }
+
+  /// spin-wait: yield first, then sleep so that idle stages do not burn a core
+  struct Backoff{
+    size_t tries = 0;
+    void Wait(){
+      if (++tries < 256) std::this_thread::yield();
+      else std::this_thread::sleep_for(std::chrono::microseconds(20));
+    }
+  };
+
+  Pipeline::Pipeline(size_t nBuffers)
+    : _abort(false)
+  {
+
+    if (nBuffers == 0)
+      nBuffers = 1;
+
+    for (size_t i=0; i < nBuffers; i++)
+      _events.emplace_back(new Event());
+
+    for (size_t s=0; s < kNStages; s++)
+      _stage_stats[s] = StageStats();
+  }
+
+
+  void Pipeline::Configure(const std::function<void(Manager&)>& f){
+
+    for (auto& ev : _events)
+      f(ev->manager);
+
+    return;
+  }
+
+
+  size_t Pipeline::Run(){
+
+    if (!_ingest)
+      throw ::geoalgo::GeoAlgoException("Pipeline: no ingest function set");
+
+    // each queue can hold every buffer (+ the end marker): pushes never
+    // block for long, the pool size is what limits the events in flight
+    for (size_t s=0; s < kNStages; s++){
+      _queues[s].reset(new Queue_t(_events.size()+1));
+      _stage_stats[s] = StageStats();
+    }
+    for (size_t i=0; i < _events.size(); i++)
+      _queues[kIngest]->TryPush(i);
+
+    _abort = false;
+    _ingest_error = nullptr;
+    _output_error = nullptr;
+
+    std::thread ingest(&Pipeline::IngestStage,this);
+    std::thread resolve(&Pipeline::WorkStage,this,kResolve);
+    std::thread tree(&Pipeline::WorkStage,this,kMakeTree);
+    OutputStage();
+
+    ingest.join();
+    resolve.join();
+    tree.join();
+
+    if (_ingest_error) std::rethrow_exception(_ingest_error);
+    if (_output_error) std::rethrow_exception(_output_error);
+
+    return _stage_stats[kOutput].events;
+  }
+
+
+  size_t Pipeline::Pop(Stage_t s){
+
+    auto& queue = *_queues[s];
+    auto& stats = _stage_stats[s];
+
+    size_t const depth = queue.Size();
+    size_t idx;
+    if (queue.TryPop(idx) == false){
+      stats.waits += 1;
+      Backoff backoff;
+      while (queue.TryPop(idx) == false)
+	backoff.Wait();
+    }
+
+    if (idx != kEnd){
+      stats.depth_sum += depth;
+      if (depth > stats.depth_max) stats.depth_max = depth;
+    }
+
+    return idx;
+  }
+
+
+  void Pipeline::Push(Stage_t s, size_t idx){
+
+    Backoff backoff;
+    while (_queues[s]->TryPush(idx) == false)
+      backoff.Wait();
+
+    return;
+  }
+
+
+  void Pipeline::IngestStage(){
+
+    auto& stats = _stage_stats[kIngest];
+
+    for (size_t evt=0; _abort == false; evt++){
+
+      size_t const idx = Pop(kIngest);
+      Event& ev = *_events[idx];
+
+      auto const start = PipelineClock_t::now();
+      bool more = false;
+      try{
+	ev.manager.Reset();
+	ev.number = evt;
+	ev.ok     = true;
+	ev.error.clear();
+	more = _ingest(ev.manager,evt);
+      }
+      catch (...){
+	_ingest_error = std::current_exception();
+	_abort = true;
+      }
+      stats.busy += ElapsedNs(start);
+
+      if (more == false)
+	break;
+
+      stats.events += 1;
+      Push(kResolve,idx);
+    }
+
+    Push(kResolve,kEnd);
+
+    return;
+  }
+
+
+  void Pipeline::WorkStage(Stage_t s){
+
+    auto& stats = _stage_stats[s];
+    Stage_t const next = (Stage_t)(s+1);
+
+    while (true){
+
+      size_t const idx = Pop(s);
+      if (idx == kEnd)
+	break;
+
+      Event& ev = *_events[idx];
+
+      auto const start = PipelineClock_t::now();
+      // a failed event passes through the remaining stages untouched
+      if (ev.ok){
+	try{
+	  if (s == kResolve)
+	    ev.manager.ResolveConflicts();
+	  else
+	    ev.manager.MakeTree();
+	}
+	catch (std::exception& ex){
+	  ev.ok    = false;
+	  ev.error = ex.what();
+	}
+	catch (...){
+	  ev.ok    = false;
+	  ev.error = (s == kResolve) ? "ResolveConflicts: unknown exception" : "MakeTree: unknown exception";
+	}
+      }
+      stats.busy += ElapsedNs(start);
+      stats.events += 1;
+
+      Push(next,idx);
+    }
+
+    Push(next,kEnd);
+
+    return;
+  }
+
+
+  void Pipeline::OutputStage(){
+
+    auto& stats = _stage_stats[kOutput];
+
+    while (true){
+
+      size_t const idx = Pop(kOutput);
+      if (idx == kEnd)
+	break;
+
+      auto const start = PipelineClock_t::now();
+      // after an output error keep draining so that the other stages can finish
+      if ( (_output) and (!_output_error) ){
+	try{
+	  _output(*_events[idx]);
+	}
+	catch (...){
+	  _output_error = std::current_exception();
+	  _abort = true;
+	}
+      }
+      stats.busy += ElapsedNs(start);
+      stats.events += 1;
+
+      // buffer is free again
+      Push(kIngest,idx);
+    }
+
+    return;
+  }
+
+
+  ManagerStats Pipeline::GetManagerStats() const {
+
+    ManagerStats stats;
+    for (auto const& ev : _events)
+      stats.Merge(ev->manager.GetStats());
+
+    return stats;
+  }
+
+
+  void Pipeline::Print(std::ostream& out) const {
+
+    out << "Pipeline (" << _events.size() << " buffers)" << std::endl;
+    out << std::setw(18) << "stage" << std::setw(10) << "events" << std::setw(14) << "busy [ms]"
+	<< std::setw(12) << "waits" << std::setw(12) << "mean depth" << std::setw(11) << "max depth" << std::endl;
+    for (size_t s=0; s < kNStages; s++){
+      auto const& st = _stage_stats[s];
+      out << std::setw(18) << StageName((Stage_t)s)
+	  << std::setw(10) << st.events
+	  << std::setw(14) << st.busy*1.e-6
+	  << std::setw(12) << st.waits
+	  << std::setw(12) << st.MeanDepth()
+	  << std::setw(11) << st.depth_max << std::endl;
+    }
+
+    return;
+  }
+
+
+  const char* Pipeline::StageName(Stage_t s){
+
+    switch (s){
+    case kIngest:   return "Ingest";
+    case kResolve:  return "ResolveConflicts";
+    case kMakeTree: return "MakeTree";
+    case kOutput:   return "Output";
+    default:        return "Unknown";
+    }
+  }
+
+}
+
+#endif
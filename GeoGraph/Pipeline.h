@@ -0,0 +1,168 @@
+/**
+ * \file Pipeline.h
+ *
+ * \ingroup GeoTree
+ *
+ * \brief Class def header for a class geotree::Pipeline
+ *
+ * @author david caratelli
+ */
+
+/** \addtogroup GeoTree
+    Streaming mode: ingestion, ResolveConflicts, MakeTree and
+    output run as separate stages, each on its own thread, so
+    that different events are processed at the same time.
+    - Events live in a fixed pool of buffers (one Manager each)
+      which are recycled once the output stage is done with them.
+      The pool size bounds the number of events in flight: the
+      ingest stage waits for a free buffer (backpressure).
+    - Stages are connected by bounded lock-free SPSC queues
+      carrying buffer indices.
+    - For each stage the depth of its input queue is sampled
+      every time an event is taken, together with the busy time
+      and the number of times the stage found nothing to do.
+      The stage whose input queue is full most of the time is
+      downstream of the bottleneck; the stage that waits the
+      least is the bottleneck.
+    Usage:
+    Pipeline p(8);
+    p.Configure([](Manager& m){ m.setLoose(true); });
+    p.SetIngest([&](Manager& m, size_t evt){ if (evt == nev) return false; gen.Generate(); gen.Fill(m); return true; });
+    p.SetOutput([](Pipeline::Event& e){ if (e.ok) e.manager.Diagram(); });
+    p.Run();
+    @{*/
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include "Manager.h"
+#include "SPSCQueue.h"
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace geotree{
+
+  /**
+     \class geotree::Pipeline
+     Runs the per-event processing as a chain of threads
+  */
+  class Pipeline{
+
+  public:
+
+    /// One event buffer
+    struct Event{
+      /// manager holding the event
+      Manager manager;
+      /// sequence number of the event (0, 1, ...)
+      size_t number;
+      /// false if ResolveConflicts or MakeTree threw
+      bool ok;
+      /// exception message when ok == false (a generic one for
+      /// exceptions not derived from std::exception)
+      std::string error;
+    };
+
+    /// Fill the manager with event number evt. Return false when there are no more events
+    typedef std::function<bool(Manager&, size_t)> Ingest_t;
+
+    /// Consume a processed event (called in event order)
+    typedef std::function<void(Event&)> Output_t;
+
+    /// Stages, in processing order
+    enum Stage_t {
+      kIngest,
+      kResolve,
+      kMakeTree,
+      kOutput,
+      kNStages
+    };
+
+    /// Per-stage metrics
+    struct StageStats{
+      /// events processed
+      size_t events;
+      /// time spent processing [ns]
+      uint64_t busy;
+      /// number of times the input queue was found empty
+      size_t waits;
+      /// input queue depth sampled each time an event is taken
+      size_t depth_sum;
+      size_t depth_max;
+      /// mean input queue depth
+      double MeanDepth() const { return (events > 0) ? (double)depth_sum/events : 0.; }
+    };
+
+    /// Constructor: number of event buffers in the pool (at least 1)
+    Pipeline(size_t nBuffers = 8);
+
+    virtual ~Pipeline(){}
+
+    /// Apply a setting to the manager of every buffer (e.g. setLoose)
+    void Configure(const std::function<void(Manager&)>& f);
+
+    /// Set the ingest / output stage functions
+    void SetIngest(const Ingest_t& f) { _ingest = f; }
+    void SetOutput(const Output_t& f) { _output = f; }
+
+    /// Process events until the ingest function returns false.
+    /// Blocks until all events went through the output stage and
+    /// returns their number. Exceptions thrown by the ingest or
+    /// output functions stop the stream and are rethrown here.
+    size_t Run();
+
+    /// Metrics of the last Run()
+    const StageStats& GetStageStats(Stage_t s) const { return _stage_stats[s]; }
+
+    /// Timers / counters of all buffer managers combined
+    ManagerStats GetManagerStats() const;
+
+    /// Number of event buffers
+    size_t Buffers() const { return _events.size(); }
+
+    /// Print stage metrics
+    void Print(std::ostream& out) const;
+
+    static const char* StageName(Stage_t s);
+
+  private:
+
+    typedef SPSCQueue<size_t> Queue_t;
+
+    /// marks the end of the stream in a queue
+    static const size_t kEnd = (size_t)-1;
+
+    /// body of each stage thread
+    void IngestStage();
+    void WorkStage(Stage_t s);
+    void OutputStage();
+
+    /// take the next buffer index from the input queue of stage s (waits)
+    size_t Pop(Stage_t s);
+
+    /// hand a buffer index to the input queue of stage s (waits)
+    void Push(Stage_t s, size_t idx);
+
+    std::vector< std::unique_ptr<Event> > _events;
+
+    /// _queues[s] is the input queue of stage s.
+    /// The input of kIngest is the list of free buffers
+    std::unique_ptr<Queue_t> _queues[kNStages];
+
+    StageStats _stage_stats[kNStages];
+
+    Ingest_t _ingest;
+    Output_t _output;
+
+    /// set when the ingest or output function threw
+    std::atomic<bool> _abort;
+    std::exception_ptr _ingest_error;
+    std::exception_ptr _output_error;
+
+  };
+
+}
+
+#endif
+/** @} */ // end of doxygen group
@@ -0,0 +1,72 @@
+/**
+ * \file PruneConfig.h
+ *
+ * \ingroup GeoTree
+ *
+ * \brief Class def header for a class geotree::PruneConfig
+ *
+ * @author david caratelli
+ */
+
+/** \addtogroup GeoTree
+    Settings of the pruning pass (Manager::Prune) which removes
+    weak correlations before the conflicts are resolved, in one
+    sweep over the nodes. Each node decides on the correlations
+    it holds as child (its parents) and as sibling; a pair is
+    removed from both nodes if either end drops it.
+    Steps, in this order:
+    - score floors: parents / siblings scoring below the floor
+    - dominated parents: all parents but the one FindBestParent
+      would keep (highest score > 0, lowest ID on ties). This step
+      does not change the result of ResolveConflicts.
+    - top-K: keep the K best parents / siblings of each node
+      (highest score, lowest ID on ties). Bounds the node degree
+      and so the cost of the resolution passes on dense events.
+    The default configuration prunes nothing.
+    @{*/
+#ifndef PRUNECONFIG_H
+#define PRUNECONFIG_H
+
+#include <cstddef>
+#include <limits>
+
+namespace geotree{
+
+  /**
+     \class geotree::PruneConfig
+     Thresholds for the pruning pass
+  */
+  struct PruneConfig{
+
+    /// keep at most this many parents per node (0: no limit)
+    size_t maxParents;
+    /// keep at most this many siblings per node (0: no limit)
+    size_t maxSiblings;
+    /// drop parent-child correlations scoring below this
+    double parentFloor;
+    /// drop sibling correlations scoring below this
+    double siblingFloor;
+    /// drop parents that FindBestParent would remove anyway
+    bool dropDominated;
+
+    PruneConfig()
+      : maxParents(0)
+      , maxSiblings(0)
+      , parentFloor(-std::numeric_limits<double>::max())
+      , siblingFloor(-std::numeric_limits<double>::max())
+      , dropDominated(false)
+    {}
+
+    /// does this configuration remove anything?
+    bool Enabled() const {
+      return ( (maxParents > 0) or (maxSiblings > 0) or dropDominated or
+	       (parentFloor  > -std::numeric_limits<double>::max()) or
+	       (siblingFloor > -std::numeric_limits<double>::max()) );
+    }
+
+  };
+
+}
+
+#endif
+/** @} */ // end of doxygen group
@@ -0,0 +1,96 @@
+/**
+ * \file SPSCQueue.h
+ *
+ * \ingroup GeoTree
+ *
+ * \brief Class def header for a class geotree::SPSCQueue
+ *
+ * @author david caratelli
+ */
+
+/** \addtogroup GeoTree
+    Bounded lock-free queue with one producer thread
+    and one consumer thread (ring buffer with atomic
+    head / tail indices). Used between the stages of
+    geotree::Pipeline.
+    @{*/
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace geotree{
+
+  /**
+     \class geotree::SPSCQueue
+     Fixed-capacity FIFO. TryPush may only be called
+     from one thread and TryPop from one (other) thread.
+  */
+  template <class T>
+  class SPSCQueue{
+
+  public:
+
+    /// Capacity is rounded up to a power of two
+    explicit SPSCQueue(size_t capacity)
+      : _head(0), _tail(0)
+    {
+      size_t size = 2;
+      while (size < capacity) size *= 2;
+      _buffer.resize(size);
+      _mask = size-1;
+      _capacity = capacity;
+    }
+
+    /// Add an element. False if the queue is full
+    bool TryPush(const T& value)
+    {
+      size_t const tail = _tail.load(std::memory_order_relaxed);
+      if (tail - _head.load(std::memory_order_acquire) >= _capacity)
+	return false;
+      _buffer[tail & _mask] = value;
+      _tail.store(tail+1,std::memory_order_release);
+      return true;
+    }
+
+    /// Remove the oldest element. False if the queue is empty
+    bool TryPop(T& value)
+    {
+      size_t const head = _head.load(std::memory_order_relaxed);
+      if (head == _tail.load(std::memory_order_acquire))
+	return false;
+      value = _buffer[head & _mask];
+      _head.store(head+1,std::memory_order_release);
+      return true;
+    }
+
+    /// Number of elements (exact only from the producer or consumer thread)
+    size_t Size() const
+    {
+      return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire);
+    }
+
+    size_t Capacity() const { return _capacity; }
+
+  private:
+
+    std::vector<T> _buffer;
+    size_t _mask;
+    size_t _capacity;
+
+    // consumer and producer indices on separate cache lines
+    // (padding rather than alignas: C++11 new ignores over-alignment)
+    char _pad0[64];
+    std::atomic<size_t> _head;
+    char _pad1[64];
+    std::atomic<size_t> _tail;
+    char _pad2[64];
+
+  };
+
+}
+
+#endif
+/** @} */ // end of doxygen group
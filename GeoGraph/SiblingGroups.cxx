@@ -0,0 +1,125 @@
+#ifndef SIBLINGGROUPS_CXX
+#define SIBLINGGROUPS_CXX
+
+#include "SiblingGroups.h"
+#include <utility>
+
+namespace geotree{
+
+  void SiblingGroups::Reset(size_t n){
+
+    _parent.resize(n);
+    for (size_t i=0; i < n; i++)
+      _parent[i] = i;
+    _size.assign(n,1);
+    _vtx.assign(n,0);
+    _hasVtx.assign(n,false);
+    _score.assign(n,0.);
+    _settled.assign(n,false);
+    _offset.clear();
+    _members.clear();
+
+    return;
+  }
+
+
+  size_t SiblingGroups::Find(size_t i) const noexcept {
+
+    while (_parent[i] != i)
+      i = _parent[i];
+
+    return i;
+  }
+
+
+  size_t SiblingGroups::Merge(size_t a, size_t b) noexcept {
+
+    size_t ra = Find(a);
+    size_t rb = Find(b);
+    if (ra == rb)
+      return ra;
+
+    // union by size
+    if (_size[ra] < _size[rb])
+      std::swap(ra,rb);
+    _parent[rb] = ra;
+    _size[ra] += _size[rb];
+    _hasVtx[ra] = false;
+    _settled[ra] = false;
+    _score[ra] = 0.;
+
+    // compress the paths just walked
+    while (_parent[a] != ra) { size_t const next = _parent[a]; _parent[a] = ra; a = next; }
+    while (_parent[b] != ra) { size_t const next = _parent[b]; _parent[b] = ra; b = next; }
+
+    // member lists are out of date
+    _offset.clear();
+
+    return ra;
+  }
+
+
+  void SiblingGroups::SetVertex(size_t i, VertexID_t vtx) noexcept {
+
+    size_t const r = Find(i);
+    _vtx[r] = vtx;
+    _hasVtx[r] = true;
+
+    return;
+  }
+
+
+  void SiblingGroups::Index(){
+
+    size_t const n = _parent.size();
+
+    // counting sort of the nodes by representative
+    _offset.assign(n+1,0);
+    for (size_t i=0; i < n; i++)
+      _offset[Find(i)+1] += 1;
+    for (size_t i=0; i < n; i++)
+      _offset[i+1] += _offset[i];
+
+    _members.resize(n);
+    std::vector<size_t> fill(_offset.begin(),_offset.end()-1);
+    for (size_t i=0; i < n; i++)
+      _members[fill[Find(i)]++] = i;
+
+    return;
+  }
+
+
+  SiblingGroups::MemberRange SiblingGroups::GetMembers(size_t i) const {
+
+    if (_offset.size() != _parent.size()+1)
+      throw ::geoalgo::GeoAlgoException("SiblingGroups: member lists are out of date (call Index)");
+
+    size_t const r = Find(i);
+    return MemberRange(_members.data()+_offset[r],_members.data()+_offset[r+1]);
+  }
+
+
+  size_t SiblingGroups::NGroups() const {
+
+    size_t groups = 0;
+    for (size_t i=0; i < _parent.size(); i++)
+      if ( (_parent[i] == i) and (_size[i] > 1) )
+	groups += 1;
+
+    return groups;
+  }
+
+
+  void SiblingGroups::AddMemoryUsage(MemoryUsage_t& usage) const {
+
+    usage.scratch += (_parent.capacity() + _size.capacity() + _offset.capacity() + _members.capacity())*sizeof(size_t);
+    usage.scratch += _vtx.capacity()*sizeof(VertexID_t);
+    usage.scratch += _score.capacity()*sizeof(double);
+    usage.scratch += (_hasVtx.capacity() + _settled.capacity())/8;
+
+    return;
+  }
+
+}
+
+#endif
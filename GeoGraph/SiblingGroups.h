@@ -0,0 +1,117 @@
+/**
+ * \file SiblingGroups.h
+ *
+ * \ingroup GeoTree
+ *
+ * \brief Class def header for a class geotree::SiblingGroups
+ *
+ * @author david caratelli
+ */
+
+/** \addtogroup GeoTree
+    Sibling groups of an event: nodes that come from a common
+    vertex. Members are node positions in the NodeCollection
+    (see NodeCollection::FindIndex). Membership is a disjoint set
+    (union by size, path compression), so forming and merging
+    groups over all the sibling correlations of an event is
+    near-linear. Each group carries the vertex (VertexTable ID)
+    and the score it shares.
+    Index() lists the members of every group in one counting
+    pass; the lists are valid until the next Merge or Reset.
+    @{*/
+#ifndef SIBLINGGROUPS_H
+#define SIBLINGGROUPS_H
+
+#include "VertexTable.h"
+#include <cstddef>
+#include <vector>
+
+namespace geotree{
+
+  /**
+     \class geotree::SiblingGroups
+     Disjoint sets of sibling nodes with a shared vertex and score
+  */
+  class SiblingGroups{
+
+  public:
+
+    /// range over the members of a group (node positions)
+    class MemberRange{
+    public:
+      MemberRange(const size_t* begin, const size_t* end) : _begin(begin), _end(end) {}
+      const size_t* begin() const { return _begin; }
+      const size_t* end()   const { return _end; }
+      size_t size() const { return (size_t)(_end - _begin); }
+    private:
+      const size_t* _begin;
+      const size_t* _end;
+    };
+
+    SiblingGroups(){}
+
+    virtual ~SiblingGroups(){}
+
+    /// n nodes, each in a group of its own
+    void Reset(size_t n);
+
+    /// number of nodes
+    size_t Size() const { return _parent.size(); }
+
+    /// representative of the group of a node
+    size_t Find(size_t i) const noexcept;
+
+    /// merge the groups of two nodes. Returns the new representative.
+    /// The merged group is unsettled and has no vertex
+    size_t Merge(size_t a, size_t b) noexcept;
+
+    /// number of members in the group of a node
+    size_t Members(size_t i) const noexcept { return _size[Find(i)]; }
+
+    /// shared vertex of the group of a node
+    bool HasVertex(size_t i) const noexcept { return _hasVtx[Find(i)]; }
+    VertexID_t Vertex(size_t i) const noexcept { return _vtx[Find(i)]; }
+    void SetVertex(size_t i, VertexID_t vtx) noexcept;
+
+    /// shared score of the group of a node
+    double Score(size_t i) const noexcept { return _score[Find(i)]; }
+    void SetScore(size_t i, double score) noexcept { _score[Find(i)] = score; }
+
+    /// the correlations among the members are all in their final
+    /// state (see Manager::SortSiblings): cleared by Merge
+    bool Settled(size_t i) const noexcept { return _settled[Find(i)]; }
+    void Settle(size_t i) noexcept { _settled[Find(i)] = true; }
+
+    /// list the members of all groups (in node order within a group)
+    void Index();
+
+    /// members of the group of a node (after Index)
+    MemberRange GetMembers(size_t i) const;
+
+    /// number of groups with more than one member
+    size_t NGroups() const;
+
+    /// Add the memory held by the groups to a report
+    void AddMemoryUsage(MemoryUsage_t& usage) const;
+
+  private:
+
+    /// union-find links (a representative points to itself)
+    std::vector<size_t> _parent;
+    /// the following are valid at the representative
+    std::vector<size_t> _size;
+    std::vector<VertexID_t> _vtx;
+    std::vector<bool> _hasVtx;
+    std::vector<double> _score;
+    std::vector<bool> _settled;
+
+    /// members grouped by representative (filled by Index)
+    std::vector<size_t> _offset;
+    std::vector<size_t> _members;
+
+  };
+
+}
+
+#endif
+/** @} */ // end of doxygen group
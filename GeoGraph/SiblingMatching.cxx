@@ -0,0 +1,205 @@
+#ifndef SIBLINGMATCHING_CXX
+#define SIBLINGMATCHING_CXX
+
+#include "SiblingMatching.h"
+#include <algorithm>
+
+namespace geotree{
+
+  const size_t SiblingMatching::kNone;
+
+
+  void SiblingMatching::Reset(){
+
+    _conflicts.clear();
+    _edges.clear();
+
+    return;
+  }
+
+
+  void SiblingMatching::AddEdge(NodeID_t sibling, double score){
+
+    NodeID_t const id = _conflicts.back().first;
+    size_t const c = _conflicts.back().second;
+
+    Edge_t edge;
+    edge.score = score;
+    edge.lo    = (id < sibling) ? id : sibling;
+    edge.hi    = (id < sibling) ? sibling : id;
+    edge.cLo   = (id < sibling) ? c : kNone;
+    edge.cHi   = (id < sibling) ? kNone : c;
+    edge.kept  = false;
+    _edges.push_back(edge);
+
+    return;
+  }
+
+
+  size_t SiblingMatching::Find(NodeID_t id) const {
+
+    auto const it = std::lower_bound(_conflicts.begin(),_conflicts.end(),id,
+				     [](const std::pair<NodeID_t,size_t>& c, NodeID_t n) { return c.first < n; });
+    if ( (it == _conflicts.end()) or (it->first != id) )
+      return kNone;
+
+    return it->second;
+  }
+
+
+  void SiblingMatching::Index(){
+
+    std::sort(_conflicts.begin(),_conflicts.end());
+
+    // an edge between two conflicts was added by both:
+    // keep the copy added by the lower ID
+    size_t n = 0;
+    for (size_t i=0; i < _edges.size(); i++){
+      Edge_t& e = _edges[i];
+      if (e.cLo != kNone)
+	e.cHi = Find(e.hi);
+      else if ( (e.cLo = Find(e.lo)) != kNone )
+	continue;
+      _edges[n++] = e;
+    }
+    _edges.resize(n);
+
+    return;
+  }
+
+
+  // A node is a conflict when it has siblings at more than one
+  // vertex. The sibling correlations of the conflicts are edges
+  // weighted by their score. The greedy matching takes the edges by
+  // decreasing score (ties by the lower, then the higher node ID) and
+  // keeps an edge if its score is positive and neither of its
+  // conflicts is matched yet. A node that is not a conflict (its
+  // siblings share one vertex) can keep several edges, as it would
+  // in the per-node pass.
+  // The kept weight is at least half the best one, and can be less
+  // (edges a-b 0.6, b-c 1.0, c-d 0.6: b-c is kept, 1.0 instead of
+  // 1.2). Every pair of siblings that are each other's highest-score
+  // sibling (without ties) is kept.
+  // The edges are not all sorted: the locally dominant ones (the
+  // best available edge of each of their conflicts) are exactly the
+  // ones the greedy pass keeps, and after a match only the neighbors
+  // of the conflicts just matched are looked at again. With the
+  // edges of each conflict sorted, that is O(C log C + E log d) for
+  // C conflicts with d siblings each.
+  // A correlation between two conflicts is added from both ends:
+  // Index finds which siblings are conflicts too and keeps one copy
+  // of each edge. The buffers keep their capacity from one event to
+  // the next.
+  size_t SiblingMatching::Solve(){
+
+    Index();
+    size_t const n = _conflicts.size();
+
+    // edges of each conflict that can be kept (positive score)
+    _offset.assign(n+1,0);
+    for (auto& e : _edges){
+      e.kept = false;
+      if (e.score <= 0)
+	continue;
+      if (e.cLo != kNone) _offset[e.cLo+1] += 1;
+      if (e.cHi != kNone) _offset[e.cHi+1] += 1;
+    }
+    for (size_t c=0; c < n; c++)
+      _offset[c+1] += _offset[c];
+    _adj.resize(_offset[n]);
+    _cursor.assign(_offset.begin(),_offset.end()-1);
+    for (size_t i=0; i < _edges.size(); i++){
+      auto const& e = _edges[i];
+      if (e.score <= 0)
+	continue;
+      if (e.cLo != kNone) _adj[_cursor[e.cLo]++] = i;
+      if (e.cHi != kNone) _adj[_cursor[e.cHi]++] = i;
+    }
+
+    // best edge first at each conflict
+    _matched.assign(n,false);
+    _queue.clear();
+    for (size_t c=0; c < n; c++){
+      _cursor[c] = _offset[c];
+      std::sort(_adj.begin()+_offset[c],_adj.begin()+_offset[c+1],
+		[this](size_t i, size_t j){ return Before(_edges[i],_edges[j]); });
+      _queue.push_back(c);
+    }
+
+    // an edge that is the best available one of each of its
+    // conflicts is kept by the greedy pass over all the edges
+    // too (nothing before it can take its nodes). Keeping it can
+    // only change the best edge of the neighbors of its conflicts
+    size_t kept = 0;
+    while (_queue.empty() == false){
+      size_t const c = _queue.back();
+      _queue.pop_back();
+      if (_matched[c])
+	continue;
+      size_t const i = Best(c);
+      if (i == kNone)
+	continue;
+      size_t const other = Other(_edges[i],c);
+      if ( (other != kNone) and (Best(other) != i) )
+	continue;
+      _edges[i].kept = true;
+      kept += 1;
+      _matched[c] = true;
+      Wake(c);
+      if (other != kNone){
+	_matched[other] = true;
+	Wake(other);
+      }
+    }
+
+    return kept;
+  }
+
+
+  bool SiblingMatching::Before(const Edge_t& a, const Edge_t& b){
+
+    if (a.score != b.score) return a.score > b.score;
+    if (a.lo != b.lo) return a.lo < b.lo;
+    return a.hi < b.hi;
+  }
+
+
+  size_t SiblingMatching::Best(size_t c){
+
+    // skip the edges whose other node is a matched conflict
+    while (_cursor[c] < _offset[c+1]){
+      size_t const other = Other(_edges[_adj[_cursor[c]]],c);
+      if ( (other == kNone) or (_matched[other] == false) )
+	return _adj[_cursor[c]];
+      _cursor[c] += 1;
+    }
+
+    return kNone;
+  }
+
+
+  void SiblingMatching::Wake(size_t c){
+
+    for (size_t k=_offset[c]; k < _offset[c+1]; k++){
+      size_t const other = Other(_edges[_adj[k]],c);
+      if ( (other != kNone) and (_matched[other] == false) )
+	_queue.push_back(other);
+    }
+
+    return;
+  }
+
+
+  void SiblingMatching::AddMemoryUsage(MemoryUsage_t& usage) const {
+
+    usage.scratch += _conflicts.capacity()*sizeof(std::pair<NodeID_t,size_t>);
+    usage.scratch += _edges.capacity()*sizeof(Edge_t);
+    usage.scratch += (_offset.capacity() + _adj.capacity() + _cursor.capacity() + _queue.capacity())*sizeof(size_t);
+    usage.scratch += _matched.capacity()/8;
+
+    return;
+  }
+
+}
+
+#endif
@@ -0,0 +1,108 @@
+/**
+ * \file SiblingMatching.h
+ *
+ * \ingroup GeoTree
+ *
+ * \brief Class def header for a class geotree::SiblingMatching
+ *
+ * @author david caratelli
+ */
+
+/** \addtogroup GeoTree
+    Global choice of sibling pairs for strict mode (see
+    Manager::setSiblingMatching). Solve keeps a greedy matching of
+    the conflicting sibling correlations: a 1/2-approximation of a
+    maximum-weight matching, not an exact one. The result only
+    depends on the node IDs and scores, not on insertion order.
+    @{*/
+#ifndef SIBLINGMATCHING_H
+#define SIBLINGMATCHING_H
+
+#include "Node.h"
+#include "MemoryUsage.h"
+#include <cstddef>
+#include <vector>
+
+namespace geotree{
+
+  /**
+     \class geotree::SiblingMatching
+     Greedy (1/2-approximate, not maximum-weight) matching of
+     conflicting sibling correlations
+  */
+  class SiblingMatching{
+
+  public:
+
+    /// not a conflict
+    static const size_t kNone = (size_t)-1;
+
+    /// a sibling correlation (lo < hi by ID) and the conflict
+    /// index of its nodes (kNone if not a conflict: the end it was
+    /// added from is set by AddEdge, the other one by Solve)
+    struct Edge_t {
+      double score;
+      NodeID_t lo, hi;
+      size_t cLo, cHi;
+      bool kept;
+    };
+
+    SiblingMatching(){}
+
+    virtual ~SiblingMatching(){}
+
+    /// no conflict, no edge
+    void Reset();
+
+    /// a conflict (node ID)
+    void AddConflict(NodeID_t id) { _conflicts.push_back(std::make_pair(id,_conflicts.size())); }
+
+    /// sibling correlation of the conflict added last with a node
+    void AddEdge(NodeID_t sibling, double score);
+
+    /// number of conflicts
+    size_t NConflicts() const { return _conflicts.size(); }
+
+    /// choose the edges to keep (greedy, at least half the weight
+    /// of a maximum-weight matching). Returns their number
+    size_t Solve();
+
+    /// the edges, as added (kept: chosen by Solve)
+    const std::vector<Edge_t>& Edges() const { return _edges; }
+
+    /// Add the memory held by the buffers to a report
+    void AddMemoryUsage(MemoryUsage_t& usage) const;
+
+  private:
+
+    /// conflicts (ID, index in the order added), by ID after Index
+    std::vector< std::pair<NodeID_t,size_t> > _conflicts;
+    std::vector<Edge_t> _edges;
+
+    /// Solve, by conflict index: edges (positive score, best first),
+    /// first one not yet ruled out, matched; conflicts to look at
+    std::vector<size_t> _offset;
+    std::vector<size_t> _adj;
+    std::vector<size_t> _cursor;
+    std::vector<bool> _matched;
+    std::vector<size_t> _queue;
+
+    /// conflict index of a node (kNone if it is not a conflict)
+    size_t Find(NodeID_t id) const;
+    /// sort the conflicts, index the edges and drop the copies
+    void Index();
+    /// does a come before b (higher score, then lower IDs)?
+    static bool Before(const Edge_t& a, const Edge_t& b);
+    /// the other conflict of an edge (kNone if the other node is not one)
+    static size_t Other(const Edge_t& e, size_t c) { return (e.cLo == c) ? e.cHi : e.cLo; }
+    /// best edge of a conflict whose other node is free (kNone if none)
+    size_t Best(size_t c);
+    /// look again at the free conflicts correlated to a conflict
+    void Wake(size_t c);
+
+  };
+
+}
+
+#endif
+/** @} */ // end of doxygen group
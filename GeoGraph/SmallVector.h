@@ -0,0 +1,166 @@
+/**
+ * \file SmallVector.h
+ *
+ * \ingroup GeoTree
+ *
+ * \brief Class def header for a class geotree::SmallVector
+ *
+ * @author david caratelli
+ */
+
+/** \addtogroup GeoTree
+    Vector with room for N elements inside the object itself:
+    no heap allocation until more than N elements are stored.
+    Used for lists of node IDs (children, siblings, parents)
+    which almost always hold a handful of entries.
+    Only for trivial types (IDs, numbers): elements are copied
+    bitwise and never destroyed.
+    clear() keeps the capacity, so a buffer owned by the caller
+    can be refilled without allocating.
+    @{*/
+#ifndef SMALLVECTOR_H
+#define SMALLVECTOR_H
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace geotree{
+
+  /**
+     \class geotree::SmallVector
+     Vector with inline storage for N elements
+  */
+  template <class T, size_t N>
+  class SmallVector{
+
+    static_assert(std::is_trivial<T>::value, "SmallVector only holds trivial types");
+    static_assert(N > 0, "SmallVector needs inline room for at least one element");
+
+  public:
+
+    typedef T value_type;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+    typedef size_t size_type;
+
+    SmallVector() : _data(_inline), _size(0), _capacity(N) {}
+
+    template <class It>
+    SmallVector(It first, It last) : _data(_inline), _size(0), _capacity(N) { assign(first,last); }
+
+    SmallVector(const SmallVector& other) : _data(_inline), _size(0), _capacity(N) { *this = other; }
+
+    SmallVector(SmallVector&& other) noexcept : _data(_inline), _size(0), _capacity(N) { *this = std::move(other); }
+
+    ~SmallVector() { if (_data != _inline) delete[] _data; }
+
+    SmallVector& operator=(const SmallVector& other)
+    {
+      if (this != &other){
+	_size = 0;
+	reserve(other._size);
+	std::memcpy(_data,other._data,other._size*sizeof(T));
+	_size = other._size;
+      }
+      return *this;
+    }
+
+    /// never allocates: other's heap buffer is taken over, an
+    /// inline one fits in our capacity (at least N)
+    SmallVector& operator=(SmallVector&& other) noexcept
+    {
+      if (this == &other)
+	return *this;
+      // heap buffer: take it over. Inline buffer: copy
+      if (other._data != other._inline){
+	if (_data != _inline) delete[] _data;
+	_data     = other._data;
+	_size     = other._size;
+	_capacity = other._capacity;
+	other._data     = other._inline;
+	other._capacity = N;
+      }
+      else{
+	_size = 0;
+	std::memcpy(_data,other._data,other._size*sizeof(T));
+	_size = other._size;
+      }
+      other._size = 0;
+      return *this;
+    }
+
+    /// replace the content with [first, last)
+    template <class It>
+    void assign(It first, It last)
+    {
+      _size = 0;
+      for (; first != last; ++first)
+	push_back(*first);
+    }
+
+    void push_back(const T& value)
+    {
+      if (_size == _capacity){
+	// value may be one of our elements: copy it before grow frees them
+	T const copy = value;
+	grow(2*_capacity);
+	_data[_size++] = copy;
+	return;
+      }
+      _data[_size++] = value;
+    }
+
+    void pop_back() { --_size; }
+
+    /// make room for n elements
+    void reserve(size_t n) { if (n > _capacity) grow(n); }
+
+    /// remove all elements (capacity is kept)
+    void clear() { _size = 0; }
+
+    size_t size()     const { return _size; }
+    size_t capacity() const { return _capacity; }
+    bool   empty()    const { return (_size == 0); }
+
+    /// true if the elements live on the heap
+    bool onHeap() const { return (_data != _inline); }
+
+    T&       operator[](size_t i)       { return _data[i]; }
+    const T& operator[](size_t i) const { return _data[i]; }
+
+    T&       back()       { return _data[_size-1]; }
+    const T& back() const { return _data[_size-1]; }
+
+    T*       data()       { return _data; }
+    const T* data() const { return _data; }
+
+    iterator       begin()       { return _data; }
+    iterator       end()         { return _data+_size; }
+    const_iterator begin() const { return _data; }
+    const_iterator end()   const { return _data+_size; }
+
+  private:
+
+    void grow(size_t n)
+    {
+      T* data = new T[n];
+      std::memcpy(data,_data,_size*sizeof(T));
+      if (_data != _inline) delete[] _data;
+      _data = data;
+      _capacity = n;
+    }
+
+    T* _data;
+    size_t _size;
+    size_t _capacity;
+    T _inline[N];
+
+  };
+
+}
+
+#endif
+/** @} */ // end of doxygen group
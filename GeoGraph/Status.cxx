@@ -0,0 +1,24 @@
+#ifndef STATUS_CXX
+#define STATUS_CXX
+
+#include "Status.h"
+
+namespace geotree{
+
+  const char* StatusMessage(Status_t status)
+  {
+    switch (status){
+    case kSuccess:             return "Success";
+    case kNodeNotFound:        return "Node ID not found!";
+    case kCorrelationNotFound: return "Error: correlation does not exist!";
+    case kCorrelationExists:   return "Error: Adding correlation that already exists!";
+    case kProhibited:          return "Correlation is Prohibited!";
+    case kNoParent:            return "No parent when one expected! something went wrong!";
+    case kMultipleParents:     return "Node has more than 1 parent! something went wrong!";
+    default:                   return "Unknown status";
+    }
+  }
+
+}
+
+#endif
@@ -0,0 +1,42 @@
+/**
+ * \file Status.h
+ *
+ * \ingroup GeoTree
+ * 
+ * \brief Status codes returned by the non-throwing GeoTree API
+ *
+ * @author david caratelli
+ */
+
+/** \addtogroup GeoTree
+
+    The try* / Try* functions of Node, NodeCollection and Manager
+    report failures through a Status_t instead of throwing. They
+    are used by the conflict resolution passes. The ones that
+    modify the event allocate, so they are not noexcept: running
+    out of memory still throws std::bad_alloc. The public functions
+    with the historical names wrap them and throw a
+    ::geoalgo::GeoAlgoException built from StatusMessage.
+    @{*/
+#ifndef STATUS_H
+#define STATUS_H
+
+namespace geotree{
+
+  enum Status_t {
+    kSuccess,
+    kNodeNotFound,
+    kCorrelationNotFound,
+    kCorrelationExists,
+    kProhibited,
+    kNoParent,
+    kMultipleParents
+  };
+
+  /// Message used when a status is turned into an exception
+  const char* StatusMessage(Status_t status);
+
+}
+
+#endif
+/** @} */ // end of doxygen group 
@@ -0,0 +1,94 @@
+#ifndef UNDOLOG_CXX
+#define UNDOLOG_CXX
+
+#include "UndoLog.h"
+
+namespace geotree{
+
+  void UndoLog::Begin(const NodeCollection& coll){
+
+    Savepoint sp = { _records.size(), coll.ShareVertices() };
+    _savepoints.push_back(sp);
+
+    return;
+  }
+
+
+  void UndoLog::Commit(){
+
+    if (_savepoints.empty())
+      throw ::geoalgo::GeoAlgoException("Commit: no open transaction!");
+
+    _savepoints.pop_back();
+
+    // outermost transaction committed: nothing left to undo
+    if (_savepoints.empty())
+      _records.clear();
+
+    return;
+  }
+
+
+  size_t UndoLog::Rollback(NodeCollection& coll){
+
+    if (_savepoints.empty())
+      throw ::geoalgo::GeoAlgoException("Rollback: no open transaction!");
+
+    size_t const savepoint = _savepoints.back().records;
+    coll.LoadVertices(_savepoints.back().vertices);
+    _savepoints.pop_back();
+
+    // restore in reverse order: the oldest saved state of a correlation wins
+    size_t const restored = (_records.size() - savepoint)/2;
+    while (_records.size() > savepoint){
+      Restore(coll,_records.back());
+      _records.pop_back();
+    }
+
+    return restored;
+  }
+
+
+  void UndoLog::Save(const NodeID_t id1, const NodeID_t id2,
+		     const CorrelationEntry* c1,
+		     const CorrelationEntry* c2){
+
+    Record rec1 = { id1, (c1 != nullptr), (c1 != nullptr) ? *c1 : CorrelationEntry(id2,0.,0,::geotree::RelationType_t::kUnknown) };
+    Record rec2 = { id2, (c2 != nullptr), (c2 != nullptr) ? *c2 : CorrelationEntry(id1,0.,0,::geotree::RelationType_t::kUnknown) };
+    _records.push_back(rec1);
+    _records.push_back(rec2);
+
+    return;
+  }
+
+
+  void UndoLog::Restore(NodeCollection& coll, const Record& rec){
+
+    Node* node = coll.EditNode(rec.node);
+    if (node == nullptr)
+      return;
+
+    auto const& c = rec.corr;
+    if (rec.present == false){
+      node->eraseCorrelation(c.ID());
+      return;
+    }
+
+    if (node->tryEditCorrelation(c.ID(),c.Score(),c.VtxID(),c.Relation()) == kCorrelationNotFound)
+      node->tryAddCorrelation(c.ID(),c.Score(),c.VtxID(),c.Relation());
+
+    return;
+  }
+
+
+  void UndoLog::AddMemoryUsage(MemoryUsage_t& usage) const {
+
+    usage.scratch += _records.capacity()*sizeof(Record);
+    usage.scratch += _savepoints.capacity()*sizeof(Savepoint);
+
+    return;
+  }
+
+}
+
+#endif
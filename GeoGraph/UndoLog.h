@@ -0,0 +1,107 @@
+/**
+ * \file UndoLog.h
+ *
+ * \ingroup GeoTree
+ *
+ * \brief Class def header for a class geotree::UndoLog
+ *
+ * @author david caratelli
+ */
+
+/** \addtogroup GeoTree
+    Undo log for correlation edits made inside a transaction
+    (see Manager::BeginTransaction). Before a correlation
+    between two nodes is added, edited or erased, the state of
+    both ends (present or not, score, vertex, relation) is
+    saved. Rolling back restores the saved states in reverse
+    order: the cost is proportional to the number of edits,
+    not to the size of the event.
+    Transactions can be nested: each Begin() sets a savepoint.
+    A savepoint also keeps the vertex table of the event: the
+    collection copies the table before modifying it while it is
+    shared, so a rollback just puts the saved table back.
+    @{*/
+#ifndef UNDOLOG_H
+#define UNDOLOG_H
+
+#include "NodeCollection.h"
+
+namespace geotree{
+
+  /**
+     \class geotree::UndoLog
+     Stack of saved correlation states with savepoints
+  */
+  class UndoLog{
+
+  public:
+
+    UndoLog(){}
+
+    virtual ~UndoLog(){}
+
+    /// Open a (nested) transaction on a collection
+    void Begin(const NodeCollection& coll);
+
+    /// Close the innermost transaction keeping its edits.
+    /// When the outermost one is closed the log is emptied
+    void Commit();
+
+    /// Undo the edits of the innermost transaction and close it.
+    /// Returns the number of correlations restored
+    size_t Rollback(NodeCollection& coll);
+
+    /// Is a transaction open?
+    bool Active() const { return (_savepoints.empty() == false); }
+
+    /// Number of open transactions
+    size_t Depth() const { return _savepoints.size(); }
+
+    /// Number of saved states
+    size_t Size() const { return _records.size(); }
+
+    /// Drop all transactions and saved states
+    void Clear() { _records.clear(); _savepoints.clear(); }
+
+    /// Save the state of the correlation between id1 and id2.
+    /// c1: correlation stored on node id1 (w.r.t. id2), nullptr if none
+    /// c2: correlation stored on node id2 (w.r.t. id1), nullptr if none
+    void Save(const NodeID_t id1, const NodeID_t id2,
+	      const CorrelationEntry* c1,
+	      const CorrelationEntry* c2);
+
+    /// Add the memory held by the log to a report
+    void AddMemoryUsage(MemoryUsage_t& usage) const;
+
+  private:
+
+    /// state of one end of a correlation
+    struct Record{
+      /// node on which the correlation is stored
+      NodeID_t node;
+      /// was the correlation present?
+      bool present;
+      /// its value when present (the entry's ID is the other node)
+      CorrelationEntry corr;
+    };
+
+    /// start of a transaction
+    struct Savepoint{
+      /// records saved before it
+      size_t records;
+      /// vertex table when it was opened
+      std::shared_ptr<VertexTable> vertices;
+    };
+
+    /// restore one end
+    static void Restore(NodeCollection& coll, const Record& rec);
+
+    std::vector<Record> _records;
+    std::vector<Savepoint> _savepoints;
+
+  };
+
+}
+
+#endif
+/** @} */ // end of doxygen group
@@ -0,0 +1,254 @@
+#ifndef VERTEXTABLE_CXX
+#define VERTEXTABLE_CXX
+
+#include "VertexTable.h"
+#include "GeoAlgo/GeoAlgoException.h"
+#include <algorithm>
+#include <utility>
+
+namespace geotree{
+
+  VertexID_t VertexTable::Add(const ::geoalgo::Point_t& pt){
+
+    VertexID_t const id = _parent.size();
+#ifndef GEOTREE_COMPACT
+    _points.push_back(pt);
+#else
+    _xyz.resize(3*(id+1));
+    _dim.push_back(0);
+    Store(id,pt);
+#endif
+    _parent.push_back(id);
+    _size.push_back(1);
+
+    return id;
+  }
+
+
+  VertexID_t VertexTable::Add(::geoalgo::Point_t&& pt){
+
+#ifndef GEOTREE_COMPACT
+    VertexID_t const id = _parent.size();
+    _points.push_back(std::move(pt));
+    _parent.push_back(id);
+    _size.push_back(1);
+    return id;
+#else
+    return Add(static_cast<const ::geoalgo::Point_t&>(pt));
+#endif
+  }
+
+
+  VertexID_t VertexTable::Alias(VertexID_t id){
+
+    VertexID_t const r = Find(id);
+    VertexID_t const alias = _parent.size();
+#ifndef GEOTREE_COMPACT
+    // empty: the point is the representative's
+    _points.push_back(::geoalgo::Point_t());
+#else
+    _xyz.resize(3*(alias+1));
+    _dim.push_back(0);
+#endif
+    _parent.push_back(r);
+    _size.push_back(1);
+    _size[r] += 1;
+
+    return alias;
+  }
+
+
+  VertexID_t VertexTable::Find(VertexID_t id) const noexcept {
+
+    while (_parent[id] != id)
+      id = _parent[id];
+
+    return id;
+  }
+
+
+  VertexID_t VertexTable::Merge(VertexID_t a, VertexID_t b) noexcept {
+
+    VertexID_t ra = Find(a);
+    VertexID_t rb = Find(b);
+    if (ra == rb)
+      return ra;
+
+    // union by size: the smaller class hangs from the larger one,
+    // which takes the point of a's class
+    if (_size[ra] < _size[rb]){
+#ifndef GEOTREE_COMPACT
+      _points[rb].swap(_points[ra]);
+#else
+      for (size_t k=0; k < 3; k++)
+	std::swap(_xyz[3*ra+k],_xyz[3*rb+k]);
+      std::swap(_dim[ra],_dim[rb]);
+#endif
+      std::swap(ra,rb);
+    }
+    _parent[rb] = ra;
+    _size[ra] += _size[rb];
+
+    // compress the paths just walked
+    while (_parent[a] != ra) { VertexID_t const next = _parent[a]; _parent[a] = ra; a = next; }
+    while (_parent[b] != ra) { VertexID_t const next = _parent[b]; _parent[b] = ra; b = next; }
+
+    return ra;
+  }
+
+
+  VertexID_t VertexTable::MergeGroup(std::vector<VertexID_t>& ids, ::geoalgo::Point_t pt,
+				     std::vector< std::pair<VertexID_t,VertexID_t> >& scratch){
+
+    // (representative, ID) of the group: the IDs of a class together
+    scratch.clear();
+    for (auto const id : ids)
+      scratch.push_back(std::make_pair(Find(id),id));
+    std::sort(scratch.begin(),scratch.end());
+
+    // merge the classes all of whose IDs are in the group
+    bool found = false;
+    VertexID_t merged = 0;
+    for (size_t i=0; i < scratch.size(); ){
+      VertexID_t const r = scratch[i].first;
+      size_t members = 0;
+      size_t j = i;
+      for (; (j < scratch.size()) and (scratch[j].first == r); j++)
+	if ( (j == i) or (scratch[j].second != scratch[j-1].second) )
+	  members += 1;
+      if (members == _size[r]){
+	merged = found ? Merge(merged,r) : r;
+	found = true;
+      }
+      i = j;
+    }
+
+    if (found)
+      Set(merged,pt);
+    else
+      merged = Add(std::move(pt));
+    merged = Find(merged);
+
+    // the IDs of shared classes: an alias each
+    for (auto& id : ids)
+      if (Find(id) != merged)
+	id = Alias(merged);
+
+    return merged;
+  }
+
+
+  bool VertexTable::Same(VertexID_t a, VertexID_t b) const noexcept {
+
+    VertexID_t const ra = Find(a);
+    VertexID_t const rb = Find(b);
+
+    if (ra == rb)
+      return true;
+#ifndef GEOTREE_COMPACT
+    return (_points[ra] == _points[rb]);
+#else
+    if (_dim[ra] != _dim[rb])
+      return false;
+    for (size_t k=0; k < _dim[ra]; k++)
+      if (_xyz[3*ra+k] != _xyz[3*rb+k]) return false;
+    return true;
+#endif
+  }
+
+
+  bool VertexTable::XYZ(VertexID_t id, double* xyz) const noexcept {
+
+    VertexID_t const r = Find(id);
+#ifndef GEOTREE_COMPACT
+    const ::geoalgo::Point_t& pt = _points[r];
+    if (pt.size() < 3)
+      return false;
+    for (size_t k=0; k < 3; k++)
+      xyz[k] = pt[k];
+#else
+    if (_dim[r] < 3)
+      return false;
+    for (size_t k=0; k < 3; k++)
+      xyz[k] = kVertexOrigin[k] + (double)_xyz[3*r+k];
+#endif
+
+    return true;
+  }
+
+
+#ifdef GEOTREE_COMPACT
+  ::geoalgo::Point_t VertexTable::Get(VertexID_t id) const {
+
+    VertexID_t const r = Find(id);
+    ::geoalgo::Point_t pt(_dim[r]);
+    for (size_t k=0; k < _dim[r]; k++)
+      pt[k] = kVertexOrigin[k] + (double)_xyz[3*r+k];
+
+    return pt;
+  }
+
+
+  void VertexTable::Store(VertexID_t id, const ::geoalgo::Point_t& pt){
+
+    if (pt.size() > 3)
+      throw ::geoalgo::GeoAlgoException("VertexTable: compact storage holds at most 3 coordinates");
+
+    _dim[id] = pt.size();
+    for (size_t k=0; k < 3; k++)
+      _xyz[3*id+k] = (k < pt.size()) ? (Coord_t)(pt[k] - kVertexOrigin[k]) : 0;
+
+    return;
+  }
+#endif
+
+
+  void VertexTable::Clear(){
+
+#ifndef GEOTREE_COMPACT
+    _points.clear();
+#else
+    _xyz.clear();
+    _dim.clear();
+#endif
+    _parent.clear();
+    _size.clear();
+
+    return;
+  }
+
+
+  void VertexTable::Reserve(size_t n){
+
+#ifndef GEOTREE_COMPACT
+    _points.reserve(n);
+#else
+    _xyz.reserve(3*n);
+    _dim.reserve(n);
+#endif
+    _parent.reserve(n);
+    _size.reserve(n);
+
+    return;
+  }
+
+
+  void VertexTable::AddMemoryUsage(MemoryUsage_t& usage) const {
+
+#ifndef GEOTREE_COMPACT
+    usage.correlations += _points.capacity()*sizeof(::geoalgo::Point_t);
+    for (auto const& pt : _points)
+      usage.correlations += pt.capacity()*sizeof(double);
+#else
+    usage.correlations += _xyz.capacity()*sizeof(Coord_t);
+    usage.correlations += _dim.capacity()*sizeof(unsigned char);
+#endif
+    usage.correlations += _parent.capacity()*sizeof(VertexID_t);
+    usage.correlations += _size.capacity()*sizeof(unsigned int);
+
+    return;
+  }
+
+}
+
+#endif
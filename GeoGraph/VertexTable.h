@@ -0,0 +1,149 @@
+/**
+ * \file VertexTable.h
+ *
+ * \ingroup GeoTree
+ *
+ * \brief Class def header for a class geotree::VertexTable
+ *
+ * @author david caratelli
+ */
+
+/** \addtogroup GeoTree
+    Event-level table of correlation vertices.
+    A correlation stores a VertexID_t (one entry for both
+    of its nodes) instead of its own copy of the point.
+    Each correlation has an ID of its own. Correlations at a
+    common vertex have IDs of one class (union-find) that
+    shares a single point: Alias hands out a new ID of a
+    class without copying the point, and MergeGroup moves a
+    group of k correlations to a common vertex with k unions
+    instead of 2k point copies. Only classes held entirely
+    by the group are merged: a correlation whose class is
+    shared with others gets an alias, so the others keep
+    their point. Editing the vertex of a single correlation
+    gives it a new entry and leaves the rest of its class
+    untouched.
+    Entries are never removed before Clear(): vertex IDs
+    stay valid for the whole event.
+    With GEOTREE_COMPACT the points are stored as 3 float
+    coordinates relative to the detector origin (see
+    CompactStorage.h for the error bounds), and Get returns
+    the point by value.
+    @{*/
+#ifndef VERTEXTABLE_H
+#define VERTEXTABLE_H
+
+#include "GeoAlgo/GeoVector.h"
+#include "MemoryUsage.h"
+#include "CompactStorage.h"
+#include <utility>
+#include <vector>
+
+namespace geotree{
+
+  /// index of a vertex in the VertexTable of an event
+  typedef unsigned int VertexID_t;
+
+  /// what VertexTable::Get returns (a copy in compact mode:
+  /// bind it with const auto& either way)
+#ifdef GEOTREE_COMPACT
+  typedef ::geoalgo::Point_t VertexPoint_t;
+#else
+  typedef const ::geoalgo::Point_t& VertexPoint_t;
+#endif
+
+  /**
+     \class geotree::VertexTable
+     Vertex points with union-find merging
+  */
+  class VertexTable{
+
+  public:
+
+    VertexTable(){}
+
+    virtual ~VertexTable(){}
+
+    /// New vertex (its own class). Returns its ID
+    /// (compact mode: at most 3 coordinates, otherwise throws)
+    VertexID_t Add(const ::geoalgo::Point_t& pt);
+
+    /// Same, taking over the point's storage (no allocation for it)
+    VertexID_t Add(::geoalgo::Point_t&& pt);
+
+    /// New ID in the class of a vertex: it shares the class's
+    /// point (no copy of it). Returns the ID
+    VertexID_t Alias(VertexID_t id);
+
+    /// Representative of the class of a vertex
+    VertexID_t Find(VertexID_t id) const noexcept;
+
+    /// Merge the classes of two vertices. The merged class keeps
+    /// the point of a's class. Returns the new representative
+    VertexID_t Merge(VertexID_t a, VertexID_t b) noexcept;
+
+    /// Move the vertices of a group of correlations (their IDs in
+    /// ids) to pt: the classes whose IDs are all in ids are merged
+    /// and pt is set once. An ID whose class also holds IDs outside
+    /// the group is replaced in ids by an alias of the merged class:
+    /// the caller points its correlation to it. scratch is a buffer
+    /// of the caller's. Returns the representative
+    VertexID_t MergeGroup(std::vector<VertexID_t>& ids, ::geoalgo::Point_t pt,
+			  std::vector< std::pair<VertexID_t,VertexID_t> >& scratch);
+
+#ifndef GEOTREE_COMPACT
+    /// Set the point shared by the class of a vertex
+    void Set(VertexID_t id, const ::geoalgo::Point_t& pt) { _points[Find(id)] = pt; }
+
+    /// Point of a vertex (shared by its class)
+    VertexPoint_t Get(VertexID_t id) const noexcept { return _points[Find(id)]; }
+#else
+    void Set(VertexID_t id, const ::geoalgo::Point_t& pt) { Store(Find(id),pt); }
+    VertexPoint_t Get(VertexID_t id) const;
+#endif
+
+    /// First 3 coordinates of a vertex into xyz (no allocation).
+    /// false (xyz untouched) if the point has fewer than 3
+    bool XYZ(VertexID_t id, double* xyz) const noexcept;
+
+    /// Do two vertices have the same coordinates?
+    bool Same(VertexID_t a, VertexID_t b) const noexcept;
+
+    /// Number of vertex IDs handed out
+    size_t Size() const { return _parent.size(); }
+
+    /// Remove all vertices (capacity is kept)
+    void Clear();
+
+    /// Presize for n vertices
+    void Reserve(size_t n);
+
+    /// Add the memory held by the table to a report
+    void AddMemoryUsage(MemoryUsage_t& usage) const;
+
+  private:
+
+#ifndef GEOTREE_COMPACT
+    /// point of each class (valid at the representative)
+    std::vector< ::geoalgo::Point_t > _points;
+#else
+    /// coordinates of each class relative to kVertexOrigin,
+    /// 3 per ID (valid at the representative)
+    std::vector<Coord_t> _xyz;
+    /// number of coordinates of the point (0 to 3)
+    std::vector<unsigned char> _dim;
+
+    /// write the point of an entry
+    void Store(VertexID_t id, const ::geoalgo::Point_t& pt);
+#endif
+    /// union-find links (a representative points to itself)
+    std::vector<VertexID_t> _parent;
+    /// number of IDs in the class (valid at the representative)
+    std::vector<unsigned int> _size;
+
+  };
+
+}
+
+#endif
+/** @} */ // end of doxygen group
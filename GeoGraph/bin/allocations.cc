@@ -0,0 +1,322 @@
+//
+// Heap allocation harness for geotree::Manager
+// operator new / delete (and, with glibc, malloc / calloc / realloc)
+// are replaced in this program by versions that count every
+// allocation. Each allocation is attributed to the innermost
+// Manager phase running at the time (ManagerStats phase probe),
+// or to "Fill" while the event is loaded. After --warmup events,
+// which let the containers reach their working capacity, the
+// following --events events are the steady state: allocations
+// per event are reported for each phase, together with the call
+// sites that allocate most.
+// With --budget N the program fails (exit code 1) if a steady-state
+// event allocates more than N times in ResolveConflicts + MakeTree.
+// --phase-budget Name=N does the same for one phase (e.g. MakeTree=0).
+// 'make check-allocations' runs it with the budgets of the current
+// tree (bin/GNUmakefile), in strict and loose mode.
+// The counting is single-threaded: the harness runs one Manager.
+// Call sites (glibc only) are printed with backtrace_symbols: frames
+// in the shared library get function names, link with -rdynamic to
+// also get them for code compiled into the executable.
+//
+// Usage: allocations [--nodes N] [--warmup N] [--events N] [--seed S]
+//                    [--density D] [--loose] [--sites K]
+//                    [--budget N] [--phase-budget Name=N]
+//
+
+#include "GeoGraph/EventGenerator.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+#if defined(__GLIBC__)
+#include <execinfo.h>
+#endif
+
+typedef geotree::ManagerStats Stats_t;
+
+// slots: the Manager phases, then the ones of this program
+static const size_t kFill   = Stats_t::kNPhases;
+static const size_t kOther  = Stats_t::kNPhases+1;
+static const size_t kSlots  = Stats_t::kNPhases+2;
+
+// call sites: kDepth frames above the allocation function
+static const int    kSkip   = 2;
+static const int    kDepth  = 4;
+static const size_t kTable  = 4096;
+
+struct Site {
+  void* frames[kDepth];
+  size_t count;
+  size_t bytes;
+};
+
+// all state is static: nothing here allocates while counting
+static bool   g_counting = false;
+static bool   g_sites    = false;
+static bool   g_inHook   = false;
+static size_t g_stack[32];
+static size_t g_depth    = 0;
+static size_t g_count[kSlots];
+static size_t g_bytes[kSlots];
+static Site   g_table[kTable];
+static size_t g_dropped  = 0;
+
+static size_t CurrentSlot(){
+  return (g_depth == 0) ? kOther : g_stack[g_depth-1];
+}
+
+static void Probe(Stats_t::Phase_t p, bool enter){
+  if (enter){
+    if (g_depth < 32) g_stack[g_depth] = p;
+    g_depth++;
+  }
+  else if (g_depth > 0)
+    g_depth--;
+}
+
+static void RecordSite(size_t n){
+#if defined(__GLIBC__)
+  void* buf[kSkip+kDepth];
+  int got = backtrace(buf,kSkip+kDepth);
+  void* frames[kDepth] = {};
+  for (int i=kSkip; i < got; i++)
+    frames[i-kSkip] = buf[i];
+  size_t h = 0;
+  for (int i=0; i < kDepth; i++)
+    h = h*31 + (size_t)frames[i];
+  for (size_t probe=0; probe < kTable; probe++){
+    Site& s = g_table[(h+probe) % kTable];
+    if (s.count == 0)
+      std::memcpy(s.frames,frames,sizeof(frames));
+    else if (std::memcmp(s.frames,frames,sizeof(frames)) != 0)
+      continue;
+    s.count += 1;
+    s.bytes += n;
+    return;
+  }
+  g_dropped += 1;
+#else
+  (void)n;
+#endif
+}
+
+__attribute__((noinline)) static void Record(size_t n){
+  if ( (g_counting == false) or g_inHook )
+    return;
+  g_inHook = true;
+  size_t const slot = CurrentSlot();
+  g_count[slot] += 1;
+  g_bytes[slot] += n;
+  if (g_sites)
+    RecordSite(n);
+  g_inHook = false;
+}
+
+#if defined(__GLIBC__)
+extern "C" {
+  void* __libc_malloc(size_t);
+  void* __libc_calloc(size_t,size_t);
+  void* __libc_realloc(void*,size_t);
+  void  __libc_free(void*);
+  void* malloc(size_t n)            { void* p = __libc_malloc(n); Record(n); return p; }
+  void* calloc(size_t m, size_t n)  { void* p = __libc_calloc(m,n); Record(m*n); return p; }
+  void* realloc(void* q, size_t n)  { void* p = __libc_realloc(q,n); if (n > 0) Record(n); return p; }
+  void  free(void* p)               { __libc_free(p); }
+}
+static void* RawAlloc(size_t n) { return __libc_malloc(n); }
+static void  RawFree(void* p)   { __libc_free(p); }
+#else
+static void* RawAlloc(size_t n) { return std::malloc(n); }
+static void  RawFree(void* p)   { std::free(p); }
+#endif
+
+void* operator new(size_t n){
+  void* p = RawAlloc(n ? n : 1);
+  if (p == nullptr) throw std::bad_alloc();
+  Record(n);
+  return p;
+}
+void* operator new[](size_t n){
+  void* p = RawAlloc(n ? n : 1);
+  if (p == nullptr) throw std::bad_alloc();
+  Record(n);
+  return p;
+}
+void* operator new(size_t n, const std::nothrow_t&) noexcept   { void* p = RawAlloc(n ? n : 1); if (p) Record(n); return p; }
+void* operator new[](size_t n, const std::nothrow_t&) noexcept { void* p = RawAlloc(n ? n : 1); if (p) Record(n); return p; }
+void operator delete(void* p) noexcept                          { RawFree(p); }
+void operator delete[](void* p) noexcept                        { RawFree(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept   { RawFree(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { RawFree(p); }
+#if __cplusplus >= 201402L
+void operator delete(void* p, size_t) noexcept                  { RawFree(p); }
+void operator delete[](void* p, size_t) noexcept                { RawFree(p); }
+#endif
+
+static std::string SlotName(size_t slot){
+  if (slot == kFill)  return "Fill";
+  if (slot == kOther) return "(outside phases)";
+  return Stats_t::PhaseName((Stats_t::Phase_t)slot);
+}
+
+static size_t SlotFromName(const std::string& name){
+  for (size_t s=0; s < kSlots; s++)
+    if (SlotName(s) == name) return s;
+  return kSlots;
+}
+
+int main(int argc, char** argv){
+
+  size_t nNodes  = 100;
+  size_t nWarmup = 20;
+  size_t nEvents = 100;
+  size_t nSites  = 10;
+  unsigned int seed = 1;
+  bool loose     = false;
+  long budget    = -1;
+  std::vector< std::pair<size_t,long> > phaseBudgets;
+
+  geotree::EventGenerator gen;
+
+  for (int i=1; i < argc; i++){
+    std::string arg = argv[i];
+    bool hasVal = (i+1 < argc);
+    if      (arg == "--loose") { loose = true; }
+    else if (arg == "--nodes"        && hasVal) { nNodes  = strtoul(argv[++i],0,10); }
+    else if (arg == "--warmup"       && hasVal) { nWarmup = strtoul(argv[++i],0,10); }
+    else if (arg == "--events"       && hasVal) { nEvents = strtoul(argv[++i],0,10); }
+    else if (arg == "--sites"        && hasVal) { nSites  = strtoul(argv[++i],0,10); }
+    else if (arg == "--seed"         && hasVal) { seed    = strtoul(argv[++i],0,10); }
+    else if (arg == "--density"      && hasVal) { gen.SetCorrelationDensity(atof(argv[++i])); }
+    else if (arg == "--budget"       && hasVal) { budget  = atol(argv[++i]); }
+    else if (arg == "--phase-budget" && hasVal) {
+      std::string val = argv[++i];
+      size_t eq = val.find('=');
+      size_t slot = (eq == std::string::npos) ? kSlots : SlotFromName(val.substr(0,eq));
+      if (slot == kSlots){
+	std::cerr << "Bad --phase-budget (expected Phase=N): " << val << std::endl;
+	return 1;
+      }
+      phaseBudgets.push_back(std::make_pair(slot,atol(val.substr(eq+1).c_str())));
+    }
+    else{
+      std::cerr << "Unknown argument: " << arg << std::endl;
+      return 1;
+    }
+  }
+
+  gen.SetSeed(seed);
+  gen.SetNodes(nNodes);
+
+  geotree::Manager mgr;
+  mgr.setLoose(loose);
+
+  Stats_t::SetPhaseProbe(Probe);
+#if defined(__GLIBC__)
+  // the first backtrace loads the unwinder (and allocates)
+  { void* buf[4]; backtrace(buf,4); }
+#endif
+
+  // per steady-state event: allocations of each slot
+  std::vector<size_t> perEvent(nEvents*kSlots,0);
+  size_t errors = 0;
+
+  for (size_t e=0; e < nWarmup+nEvents; e++){
+
+    bool const steady = (e >= nWarmup);
+    gen.Generate();
+
+    for (size_t s=0; s < kSlots; s++) g_count[s] = 0;
+    g_sites = steady;
+    g_counting = true;
+
+    g_stack[0] = kFill; g_depth = 1;
+    gen.Fill(mgr);
+    g_depth = 0;
+    try{
+      mgr.ResolveConflicts();
+      mgr.MakeTree();
+    }
+    catch (std::exception& ex){
+      errors += 1;
+    }
+
+    g_counting = false;
+    if (steady)
+      for (size_t s=0; s < kSlots; s++)
+	perEvent[(e-nWarmup)*kSlots+s] = g_count[s];
+  }
+
+  // report: per slot mean / max allocations per event
+  std::cout << "nodes " << nNodes << " loose " << loose << " warmup " << nWarmup
+	    << " events " << nEvents << " errors " << errors << std::endl;
+  std::cout << "phase,mean_allocs_per_event,max_allocs_per_event" << std::endl;
+  size_t worst = 0;
+  double total = 0;
+  for (size_t s=0; s < kSlots; s++){
+    size_t sum = 0, mx = 0;
+    for (size_t e=0; e < nEvents; e++){
+      size_t const n = perEvent[e*kSlots+s];
+      sum += n;
+      if (n > mx) mx = n;
+    }
+    if (sum == 0) continue;
+    std::cout << SlotName(s) << "," << (double)sum/nEvents << "," << mx << std::endl;
+  }
+  // ResolveConflicts and MakeTree include their sub-phases
+  for (size_t e=0; e < nEvents; e++){
+    size_t n = 0;
+    for (size_t s=0; s < Stats_t::kNPhases; s++)
+      n += perEvent[e*kSlots+s];
+    total += n;
+    if (n > worst) worst = n;
+  }
+  std::cout << "ResolveConflicts+MakeTree," << total/nEvents << "," << worst << std::endl;
+
+  // call sites, most allocations first
+  std::vector<const Site*> sites;
+  for (size_t i=0; i < kTable; i++)
+    if (g_table[i].count > 0) sites.push_back(&g_table[i]);
+  std::sort(sites.begin(),sites.end(),[](const Site* a, const Site* b){ return a->count > b->count; });
+  if (sites.size() > nSites) sites.resize(nSites);
+  if (sites.empty() == false)
+    std::cout << "top allocation sites (allocations per event, bytes per event, call chain):" << std::endl;
+  for (auto const& s : sites){
+    std::cout << (double)s->count/nEvents << "\t" << (double)s->bytes/nEvents << std::endl;
+#if defined(__GLIBC__)
+    int n = 0;
+    while ( (n < kDepth) and (s->frames[n] != nullptr) ) n++;
+    char** names = backtrace_symbols(s->frames,n);
+    for (int i=0; i < n; i++)
+      std::cout << "\t\t" << (names ? names[i] : "?") << std::endl;
+    free(names);
+#endif
+  }
+  if (g_dropped > 0)
+    std::cout << g_dropped << " allocations not attributed to a site (table full)" << std::endl;
+
+  // budgets
+  int status = 0;
+  if ( (budget >= 0) and (worst > (size_t)budget) ){
+    std::cerr << "FAIL: " << worst << " allocations in one steady-state event, budget " << budget << std::endl;
+    status = 1;
+  }
+  for (auto const& b : phaseBudgets){
+    for (size_t e=0; e < nEvents; e++){
+      size_t const n = perEvent[e*kSlots+b.first];
+      if (n > (size_t)b.second){
+	std::cerr << "FAIL: " << n << " allocations in " << SlotName(b.first)
+		  << " in one steady-state event, budget " << b.second << std::endl;
+	status = 1;
+	break;
+      }
+    }
+  }
+
+  return status;
+}
@@ -0,0 +1,227 @@
+//
+// Scaling benchmark for geotree::Manager
+// Events are produced with geotree::EventGenerator for a range of
+// node counts. For each size the latency of ResolveConflicts and
+// MakeTree is measured per event and summarized (percentiles and
+// throughput). One line per (size, phase) is written to stdout in
+// csv (default) or json-lines format so that results can be stored
+// and compared from release to release. Progress goes to stderr.
+//
+// Usage: benchmark [--min N] [--max N] [--events N] [--seed S]
+//                  [--density D] [--primary F] [--mult-parent F]
+//                  [--parent-sibling F] [--mult-sibling F]
+//                  [--loose] [--budget SEC] [--format csv|json] [--stats]
+//                  [--beam K] [--max-parents K] [--max-siblings K]
+//                  [--parent-floor S] [--sibling-floor S] [--dominated]
+// With --beam K each event is also resolved with geotree::BeamSearch
+// of width K (phase "BeamSearch", includes MakeTree of the results).
+//
+
+#include "GeoGraph/EventGenerator.h"
+#include "GeoGraph/BeamSearch.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock_t;
+
+struct Summary {
+  size_t events;
+  double mean, p50, p90, p99, max;
+};
+
+// latencies in microseconds
+Summary Summarize(std::vector<double> lat){
+
+  Summary s = {lat.size(),0.,0.,0.,0.,0.};
+  if (lat.empty())
+    return s;
+
+  std::sort(lat.begin(),lat.end());
+  double sum = 0;
+  for (auto& l : lat) sum += l;
+  s.mean = sum/lat.size();
+  // nearest-rank percentile
+  auto pct = [&lat](double p) { size_t r = (size_t)(p*lat.size()+0.999999); return lat[(r == 0 ? 1 : r)-1]; };
+  s.p50 = pct(0.50);
+  s.p90 = pct(0.90);
+  s.p99 = pct(0.99);
+  s.max = lat.back();
+  return s;
+}
+
+void Print(const std::string& format, size_t nodes, bool loose, const std::string& phase,
+	   const Summary& s, size_t errors, double avg_corr){
+
+  double throughput = (s.mean > 0) ? 1.e6/s.mean : 0.;
+  if (format == "json"){
+    std::cout << "{\"nodes\": " << nodes
+	      << ", \"loose\": " << (loose ? "true" : "false")
+	      << ", \"phase\": \"" << phase << "\""
+	      << ", \"events\": " << s.events
+	      << ", \"errors\": " << errors
+	      << ", \"correlations\": " << avg_corr
+	      << ", \"mean_us\": " << s.mean
+	      << ", \"p50_us\": " << s.p50
+	      << ", \"p90_us\": " << s.p90
+	      << ", \"p99_us\": " << s.p99
+	      << ", \"max_us\": " << s.max
+	      << ", \"events_per_s\": " << throughput
+	      << ", \"nodes_per_s\": " << throughput*nodes
+	      << "}" << std::endl;
+  }
+  else{
+    std::cout << nodes << "," << (loose ? 1 : 0) << "," << phase << ","
+	      << s.events << "," << errors << "," << avg_corr << ","
+	      << s.mean << "," << s.p50 << "," << s.p90 << "," << s.p99 << "," << s.max << ","
+	      << throughput << "," << throughput*nodes << std::endl;
+  }
+}
+
+int main(int argc, char** argv){
+
+  size_t minNodes  = 10;
+  size_t maxNodes  = 100000;
+  size_t nEvents   = 100;
+  unsigned int seed = 1;
+  double budget    = 60.;
+  bool loose       = false;
+  bool stats       = false;
+  size_t beamWidth = 0;
+  std::string format = "csv";
+
+  geotree::EventGenerator gen;
+  geotree::PruneConfig prune;
+
+  for (int i=1; i < argc; i++){
+    std::string arg = argv[i];
+    bool hasVal = (i+1 < argc);
+    if      (arg == "--loose") { loose = true; }
+    else if (arg == "--stats") { stats = true; }
+    else if (arg == "--min"            && hasVal) { minNodes = strtoul(argv[++i],0,10); }
+    else if (arg == "--max"            && hasVal) { maxNodes = strtoul(argv[++i],0,10); }
+    else if (arg == "--events"         && hasVal) { nEvents  = strtoul(argv[++i],0,10); }
+    else if (arg == "--seed"           && hasVal) { seed     = strtoul(argv[++i],0,10); }
+    else if (arg == "--budget"         && hasVal) { budget   = atof(argv[++i]); }
+    else if (arg == "--format"         && hasVal) { format   = argv[++i]; }
+    else if (arg == "--beam"           && hasVal) { beamWidth = strtoul(argv[++i],0,10); }
+    else if (arg == "--dominated")                { prune.dropDominated = true; }
+    else if (arg == "--max-parents"    && hasVal) { prune.maxParents   = strtoul(argv[++i],0,10); }
+    else if (arg == "--max-siblings"   && hasVal) { prune.maxSiblings  = strtoul(argv[++i],0,10); }
+    else if (arg == "--parent-floor"   && hasVal) { prune.parentFloor  = atof(argv[++i]); }
+    else if (arg == "--sibling-floor"  && hasVal) { prune.siblingFloor = atof(argv[++i]); }
+    else if (arg == "--density"        && hasVal) { gen.SetCorrelationDensity(atof(argv[++i])); }
+    else if (arg == "--primary"        && hasVal) { gen.SetPrimaryFraction(atof(argv[++i])); }
+    else if (arg == "--mult-parent"    && hasVal) { gen.SetMultipleParentFraction(atof(argv[++i])); }
+    else if (arg == "--parent-sibling" && hasVal) { gen.SetParentSiblingFraction(atof(argv[++i])); }
+    else if (arg == "--mult-sibling"   && hasVal) { gen.SetMultipleSiblingFraction(atof(argv[++i])); }
+    else{
+      std::cerr << "Unknown argument: " << arg << std::endl;
+      return 1;
+    }
+  }
+
+  gen.SetSeed(seed);
+
+  if (format != "json")
+    std::cout << "nodes,loose,phase,events,errors,correlations,mean_us,p50_us,p90_us,p99_us,max_us,events_per_s,nodes_per_s" << std::endl;
+
+  geotree::Manager mgr;
+  mgr.setLoose(loose);
+  mgr.setPruning(prune);
+  mgr.setMemoryTracking(stats);
+
+  geotree::BeamSearch beam(beamWidth);
+
+  // sizes: 10, 30, 100, 300, ... up to maxNodes
+  std::vector<size_t> sizes;
+  for (size_t n=10; n <= maxNodes; n*=10){
+    if (n >= minNodes) sizes.push_back(n);
+    if (3*n >= minNodes && 3*n <= maxNodes) sizes.push_back(3*n);
+  }
+
+  for (auto const& n : sizes){
+
+    gen.SetNodes(n);
+
+    mgr.ResetStats();
+    mgr.ResetPeakMemoryUsage();
+
+    std::vector<double> resolve_v, tree_v, beam_v;
+    size_t errors = 0;
+    size_t beamErrors = 0;
+    double beamGain = 0;
+    double ncorr  = 0;
+    size_t ngen   = 0;
+    auto const start = Clock_t::now();
+
+    for (size_t e=0; e < nEvents; e++){
+
+      gen.Generate();
+      gen.Fill(mgr);
+      ncorr += gen.GetCorrelations().size();
+      ngen  += 1;
+
+      try{
+	auto t0 = Clock_t::now();
+	mgr.ResolveConflicts();
+	auto t1 = Clock_t::now();
+	mgr.MakeTree();
+	auto t2 = Clock_t::now();
+	resolve_v.push_back(std::chrono::duration<double,std::micro>(t1-t0).count());
+	tree_v.push_back(std::chrono::duration<double,std::micro>(t2-t1).count());
+      }
+      catch (std::exception& ex){
+	errors += 1;
+      }
+
+      if (beamWidth > 0){
+	gen.Fill(mgr);
+	try{
+	  auto t0 = Clock_t::now();
+	  auto results = beam.Resolve(mgr);
+	  beam_v.push_back(std::chrono::duration<double,std::micro>(Clock_t::now()-t0).count());
+	  for (auto const& h : results)
+	    if (h.greedy) beamGain += results[0].score - h.score;
+	}
+	catch (std::exception& ex){
+	  beamErrors += 1;
+	}
+      }
+
+      // stop early on large sizes (keep at least 3 events)
+      double elapsed = std::chrono::duration<double>(Clock_t::now()-start).count();
+      if ( (elapsed > budget) and (e >= 2) )
+	break;
+    }
+
+    double elapsed = std::chrono::duration<double>(Clock_t::now()-start).count();
+    std::cerr << "nodes " << n << ": " << ngen << " events (" << errors << " errors) in " << elapsed << " s" << std::endl;
+
+    Print(format,n,loose,"ResolveConflicts",Summarize(resolve_v),errors,ncorr/ngen);
+    Print(format,n,loose,"MakeTree",Summarize(tree_v),errors,ncorr/ngen);
+    if (beamWidth > 0){
+      Print(format,n,loose,"BeamSearch",Summarize(beam_v),beamErrors,ncorr/ngen);
+      std::cerr << "beam search: mean score gain over greedy " << beamGain/ngen << std::endl;
+    }
+
+    // per-phase breakdown from the manager's own timers
+    if (stats){
+      mgr.GetStats().Print(std::cerr);
+      std::cerr << "peak ";
+      mgr.PeakMemoryUsage().Print(std::cerr);
+    }
+
+    // a single event taking longer than the budget: do not try larger sizes
+    if ( (ngen > 0) and (elapsed/ngen > budget) ){
+      std::cerr << "single event exceeds time budget (" << budget << " s). Stop scaling here." << std::endl;
+      break;
+    }
+  }
+
+  return 0;
+}
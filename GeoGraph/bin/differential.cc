@@ -0,0 +1,793 @@
+//
+// Differential harness for geotree::Manager
+// Random events are resolved by the frozen reference and by every
+// engine, i.e. every way the library offers to get the same result.
+// The frozen reference is a copy of Manager, NodeCollection, Node,
+// Correlation and the conflict algorithms as they were before the
+// optimizations, in namespace geotree_ref (bin/reference, built into
+// this program only; do not edit it). It does not change with the
+// library, so it catches changes that all engines share. It is not
+// compared where the library is meant to differ:
+// - strict mode with --sibling-matching (no frozen counterpart)
+// - forests of events with a parent cycle (MakeTree now breaks it,
+//   the frozen MakeTree does not return)
+// - forests the frozen MakeTree cannot make because a synthetic ID
+//   collides (synthetic IDs are now new IDs)
+// Synthetic nodes are compared by their children, and the correlations
+// MakeTree adds to them are not compared. Engines:
+// - manager:     LoadArrays, ResolveConflicts, MakeTree on a fresh
+//                Manager (the other engines are also compared with it)
+// - reuse:       one Manager for all events (capacity kept by Reset)
+// - snapshot:    the loaded graph resolved by a second Manager
+//                through Snapshot / LoadSnapshot
+// - transaction: resolved once inside a transaction, rolled back,
+//                then resolved again
+// - dominated:   PruneConfig::dropDominated (documented not to change
+//                the result)
+// - census-off:  Manager::setConflictCensus(false): every stage
+//                visits every node
+// - shuffle:     correlations added in another order; nodes too
+//                where the node order does not matter (strict mode
+//                with --sibling-matching, if only the sibling matching
+//                has conflicts to resolve)
+// - batch:       ResolveBatch (forest only)
+// - lazy:        Manager::TreeOf for every node, trees put together
+//                (forest only)
+// - beam:        BeamSearch (self-check, not compared with the
+//                reference): LastForest and the published forest are
+//                the tree of the best hypothesis, made by one MakeTree
+// For each engine the resolved correlations (after ResolveConflicts)
+// and the forest (after MakeTree) must be identical to the frozen
+// reference and to the manager engine, scores and vertices bit for
+// bit; an exception must be the same exception.
+// Events come from geotree::EventGenerator with fractions drawn per
+// event (multiple parents, parent + sibling, multiple siblings), plus
+// random extra correlations of any type (parent cycles, generic
+// conflicts), and are resolved in strict and in loose mode (with
+// --sibling-matching, strict mode uses Manager::setSiblingMatching,
+// and one event in four has sibling correlations only).
+// A failing event is shrunk (correlations removed in chunks, then one
+// at a time, then unused nodes) as long as the same engine still
+// differs, and the minimal event is printed as AddCorrelation calls.
+// Exit code 1 if any engine differs.
+//
+// Usage: differential [--events N] [--seed S] [--nodes MAX]
+//                     [--engine NAME] [--no-shrink] [--sibling-matching]
+//
+
+#include "GeoGraph/BeamSearch.h"
+#include "GeoGraph/EventGenerator.h"
+#include "reference/Manager.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+// one event, in the array layout of Manager::LoadArrays
+struct Event {
+  bool loose;
+  bool matching;
+  std::vector<long> nodes;
+  std::vector<long> id1, id2;
+  std::vector<double> score, vtx;
+  std::vector<int> type;
+  size_t Size() const { return id1.size(); }
+};
+
+// canonical text of what an engine produced
+struct Result {
+  std::string error;
+  bool hasResolved;
+  std::string resolved;
+  std::string forest;
+};
+
+static std::string Hex(double d){
+  char buf[64];
+  snprintf(buf,sizeof(buf),"%a",d);
+  return buf;
+}
+
+static void Load(geotree::Manager& mgr, const Event& ev){
+  mgr.setLoose(ev.loose);
+  mgr.setSiblingMatching(ev.matching);
+  mgr.LoadArrays(ev.nodes.size(),ev.nodes.data(),ev.Size(),ev.id1.data(),ev.id2.data(),
+		 ev.score.data(),ev.vtx.data(),ev.type.data());
+}
+
+// correlations of every node, by node ID then by the other ID
+static std::string DumpResolved(const geotree::Manager& mgr){
+  geotree::NodeCollection const coll = mgr.Snapshot();
+  std::vector<NodeID_t> IDs = coll.GetNodeIDs();
+  std::sort(IDs.begin(),IDs.end());
+  std::string out;
+  for (auto const& id : IDs){
+    for (auto const& c : coll.GetCorrelations(id)){
+      out += std::to_string(id) + " " + std::to_string(c.first) + " "
+	+ std::to_string((int)c.second.Relation()) + " " + Hex(c.second.Score());
+      for (auto const& x : c.second.Vtx())
+	out += " " + Hex(x);
+      out += "\n";
+    }
+  }
+  return out;
+}
+
+// forest rows with synthetic nodes named after their children,
+// sorted by name (row order and synthetic IDs are not compared)
+static std::string DumpForest(const Event& ev, size_t n, const long* id,
+			      const long* parent, const int* depth, const double* vtx){
+  std::set<long> const input(ev.nodes.begin(),ev.nodes.end());
+  std::vector<std::string> name(n);
+  for (size_t r=0; r < n; r++)
+    if (input.count(id[r])) name[r] = std::to_string(id[r]);
+  for (size_t r=0; r < n; r++){
+    if (input.count(id[r])) continue;
+    std::vector<long> children;
+    for (size_t c=0; c < n; c++)
+      if (parent[c] == (long)r) children.push_back(id[c]);
+    std::sort(children.begin(),children.end());
+    name[r] = "S{";
+    for (auto const& c : children) name[r] += std::to_string(c) + ",";
+    name[r] += "}";
+  }
+  std::vector<std::string> rows;
+  for (size_t r=0; r < n; r++){
+    std::string row = name[r] + " <- " + (parent[r] >= 0 ? name[parent[r]] : "-")
+      + " depth " + std::to_string(depth[r]);
+    for (size_t k=0; k < 3; k++)
+      row += " " + Hex(vtx[3*r+k]);
+    rows.push_back(row);
+  }
+  std::sort(rows.begin(),rows.end());
+  std::string out;
+  for (auto const& row : rows) out += row + "\n";
+  return out;
+}
+
+static std::string DumpForest(const Event& ev, const geotree::Manager& mgr){
+  size_t const cap = mgr.NodeCount();
+  std::vector<long> id(cap), parent(cap);
+  std::vector<int> depth(cap);
+  std::vector<double> vtx(3*cap);
+  size_t const n = mgr.FillForestArrays(cap,id.data(),parent.data(),depth.data(),vtx.data());
+  return DumpForest(ev,n,id.data(),parent.data(),depth.data(),vtx.data());
+}
+
+// resolve what is loaded in mgr
+static Result Finish(geotree::Manager& mgr, const Event& ev){
+  Result res;
+  res.hasResolved = true;
+  try{
+    mgr.ResolveConflicts();
+    res.resolved = DumpResolved(mgr);
+    mgr.MakeTree();
+    res.forest = DumpForest(ev,mgr);
+  }
+  catch (std::exception& ex){
+    res.error = ex.what();
+  }
+  return res;
+}
+
+static Result RunManager(const Event& ev){
+  geotree::Manager mgr;
+  Load(mgr,ev);
+  return Finish(mgr,ev);
+}
+
+// result of the frozen reference, with the parts that can be
+// compared (empty reason: comparable)
+struct Frozen {
+  Result res;
+  std::string skipResolved;
+  std::string skipForest;
+};
+
+static Frozen RunFrozen(const Event& ev){
+
+  Frozen out;
+  out.res.hasResolved = true;
+  // sibling matching has no frozen counterpart
+  if ( ev.matching and (ev.loose == false) ){
+    out.skipResolved = out.skipForest = "sibling matching";
+    return out;
+  }
+
+  geotree_ref::Manager mgr;
+  geotree_ref::NodeCollection& coll = mgr.Collection();
+  mgr.setLoose(ev.loose);
+  try{
+    for (auto const& n : ev.nodes)
+      coll.AddNode(n);
+    for (size_t i=0; i < ev.Size(); i++)
+      mgr.AddCorrelation(ev.id1[i],ev.id2[i],ev.score[i],
+			 ::geoalgo::Point_t(ev.vtx[3*i],ev.vtx[3*i+1],ev.vtx[3*i+2]),
+			 (geotree_ref::RelationType_t)ev.type[i]);
+    mgr.ResolveConflicts();
+  }
+  catch (std::exception& ex){
+    out.res.error = ex.what();
+    return out;
+  }
+
+  // resolved correlations, as DumpResolved
+  std::vector<NodeID_t> IDs = coll.GetNodeIDs();
+  std::sort(IDs.begin(),IDs.end());
+  for (auto const& id : IDs){
+    for (auto const& c : coll.GetNode(id).getCorrelations()){
+      out.res.resolved += std::to_string(id) + " " + std::to_string(c.first) + " "
+	+ std::to_string((int)c.second.Relation()) + " " + Hex(c.second.Score());
+      for (auto const& x : c.second.Vtx())
+	out.res.resolved += " " + Hex(x);
+      out.res.resolved += "\n";
+    }
+  }
+
+  // the frozen MakeTree does not return on parent cycles
+  // (MakeTree now breaks them, see Manager::BreakCycles)
+  for (auto const& id : IDs){
+    NodeID_t n = id;
+    size_t steps = 0;
+    while ( coll.GetNode(n).hasParent() and (steps <= IDs.size()) ){
+      n = coll.GetNode(n).getParent();
+      steps += 1;
+    }
+    if (steps > IDs.size()){
+      out.skipForest = "parent cycle";
+      return out;
+    }
+  }
+
+  try{
+    mgr.MakeTree();
+  }
+  catch (std::exception& ex){
+    // synthetic IDs are made differently now: not a difference
+    if (std::string(ex.what()).find("About to create a NodeID") != std::string::npos)
+      out.skipForest = "synthetic ID collision";
+    else
+      out.res.error = ex.what();
+    return out;
+  }
+
+  // forest rows: tree parents from the children lists, head nodes
+  // are the nodes without one, vertex of a node: the one shared
+  // with its first sibling, else with its tree parent
+  std::set<long> const input(ev.nodes.begin(),ev.nodes.end());
+  IDs = coll.GetNodeIDs();
+  std::map<NodeID_t,size_t> row;
+  for (size_t r=0; r < IDs.size(); r++)
+    row[IDs[r]] = r;
+  std::vector<long> id(IDs.begin(),IDs.end()), parent(IDs.size(),-1);
+  std::vector<int> depth(IDs.size(),0);
+  std::vector<double> vtx(3*IDs.size(),std::numeric_limits<double>::quiet_NaN());
+  for (size_t r=0; r < IDs.size(); r++){
+    for (auto const& c : coll.GetNode(IDs[r]).childrenID()){
+      if (parent[row[c]] >= 0){
+	out.skipForest = "node with two tree parents";
+	return out;
+      }
+      parent[row[c]] = r;
+    }
+  }
+  for (size_t r=0; r < IDs.size(); r++){
+    for (long p = parent[r]; p >= 0; p = parent[p])
+      depth[r] += 1;
+    if (input.count(IDs[r]) == 0)
+      continue;
+    geotree_ref::Node& node = coll.GetNode(IDs[r]);
+    NodeID_t other;
+    if (node.hasSiblings())
+      other = node.getSiblings()[0];
+    else if ( (parent[r] >= 0) and node.isCorrelated(IDs[parent[r]]) )
+      other = IDs[parent[r]];
+    else
+      continue;
+    ::geoalgo::Point_t const pt = node.getVtx(other);
+    for (size_t k=0; k < 3; k++)
+      vtx[3*r+k] = pt[k];
+  }
+  out.res.forest = DumpForest(ev,IDs.size(),id.data(),parent.data(),depth.data(),vtx.data());
+  return out;
+}
+
+static Result RunReuse(const Event& ev){
+  static geotree::Manager mgr;
+  Load(mgr,ev);
+  return Finish(mgr,ev);
+}
+
+static Result RunSnapshot(const Event& ev){
+  geotree::Manager src, mgr;
+  Load(src,ev);
+  mgr.setLoose(ev.loose);
+  mgr.setSiblingMatching(ev.matching);
+  mgr.LoadSnapshot(src.Snapshot());
+  src.Reset();
+  return Finish(mgr,ev);
+}
+
+static Result RunTransaction(const Event& ev){
+  geotree::Manager mgr;
+  Load(mgr,ev);
+  mgr.BeginTransaction();
+  try{
+    mgr.ResolveConflicts();
+  }
+  catch (std::exception&){}
+  mgr.Rollback();
+  return Finish(mgr,ev);
+}
+
+static Result RunDominated(const Event& ev){
+  geotree::Manager mgr;
+  geotree::PruneConfig cfg;
+  cfg.dropDominated = true;
+  mgr.setPruning(cfg);
+  Load(mgr,ev);
+  return Finish(mgr,ev);
+}
+
+static Result RunCensusOff(const Event& ev){
+  geotree::Manager mgr;
+  mgr.setConflictCensus(false);
+  Load(mgr,ev);
+  return Finish(mgr,ev);
+}
+
+// same event, correlations (and nodes if shuffleNodes) added in
+// another order
+static Event Shuffled(const Event& ev, bool shuffleNodes){
+  std::mt19937 rand(ev.nodes.size()*7919+ev.Size());
+  Event out = ev;
+  if (shuffleNodes)
+    std::shuffle(out.nodes.begin(),out.nodes.end(),rand);
+  std::vector<size_t> order(ev.Size());
+  for (size_t i=0; i < order.size(); i++) order[i] = i;
+  std::shuffle(order.begin(),order.end(),rand);
+  for (size_t i=0; i < order.size(); i++){
+    size_t const j = order[i];
+    out.id1[i] = ev.id1[j]; out.id2[i] = ev.id2[j];
+    out.score[i] = ev.score[j]; out.type[i] = ev.type[j];
+    for (size_t k=0; k < 3; k++) out.vtx[3*i+k] = ev.vtx[3*j+k];
+  }
+  return out;
+}
+
+// does the result not depend on the node order? The stages visit
+// the nodes in node order, except the sibling matching (strict mode,
+// setSiblingMatching), which only depends on IDs and scores: true if
+// it is the only stage with conflicts
+static bool NodeOrderFree(const Event& ev){
+  if ( (ev.matching == false) or ev.loose )
+    return false;
+  geotree::Manager mgr;
+  try{
+    Load(mgr,ev);
+    mgr.ResolveConflicts();
+  }
+  catch (std::exception&){
+    return false;
+  }
+  geotree::ConflictCensus const& census = mgr.GetCensus();
+  return (census.Count(geotree::ConflictCensus::kMultipleParents) == 0) and
+    (census.Count(geotree::ConflictCensus::kParentSibling) == 0);
+}
+
+static Result RunShuffle(const Event& ev){
+  geotree::Manager mgr;
+  Event const shuffled = Shuffled(ev,NodeOrderFree(ev));
+  Load(mgr,shuffled);
+  return Finish(mgr,shuffled);
+}
+
+static Result RunBatch(const Event& ev){
+  geotree::Manager mgr;
+  mgr.setLoose(ev.loose);
+  mgr.setSiblingMatching(ev.matching);
+  Result res;
+  res.hasResolved = false;
+  long const nodeInOffsets[2] = {0,(long)ev.nodes.size()};
+  long const offsets[2] = {0,(long)ev.Size()};
+  size_t const cap = 2*ev.nodes.size()+1;
+  std::vector<long> id(cap), parent(cap);
+  std::vector<int> depth(cap);
+  std::vector<double> vtx(3*cap);
+  long nodeOffsets[2] = {0,0};
+  int ok = 0;
+  try{
+    mgr.ResolveBatch(1,nodeInOffsets,ev.nodes.data(),offsets,ev.id1.data(),ev.id2.data(),
+		     ev.score.data(),ev.vtx.data(),ev.type.data(),cap,id.data(),parent.data(),
+		     depth.data(),vtx.data(),nodeOffsets,&ok);
+  }
+  catch (std::exception& ex){
+    res.error = ex.what();
+    return res;
+  }
+  // a failed event: compared with the reference's exception by its
+  // presence only (the batch does not report the message)
+  if (ok == 0){
+    res.error = "(failed)";
+    return res;
+  }
+  res.forest = DumpForest(ev,(size_t)nodeOffsets[1],id.data(),parent.data(),depth.data(),vtx.data());
+  return res;
+}
+
+static Result RunLazy(const Event& ev){
+  geotree::Manager mgr;
+  Result res;
+  res.hasResolved = false;
+  std::vector<long> id, parent;
+  std::vector<int> depth;
+  std::vector<double> vtx;
+  std::set<long> done;
+  try{
+    Load(mgr,ev);
+    for (auto const& n : ev.nodes){
+      if (done.count(n)) continue;
+      const geotree::Forest& tree = mgr.TreeOf(n);
+      long const base = id.size();
+      for (size_t r=0; r < tree.Size(); r++){
+	id.push_back(tree.ID(r));
+	parent.push_back(tree.Parent(r) >= 0 ? base+tree.Parent(r) : -1);
+	depth.push_back(tree.Depth(r));
+	for (size_t k=0; k < 3; k++) vtx.push_back(tree.Vertex(r)[k]);
+	done.insert(tree.ID(r));
+      }
+    }
+  }
+  catch (std::exception& ex){
+    res.error = ex.what();
+    return res;
+  }
+  res.forest = DumpForest(ev,id.size(),id.data(),parent.data(),depth.data(),vtx.data());
+  return res;
+}
+
+// (node, tree parent) pairs of a forest, -1 for head nodes
+static std::vector< std::pair<long,long> > TreeLinks(const geotree::Forest& forest){
+  std::vector< std::pair<long,long> > links;
+  for (size_t r=0; r < forest.Size(); r++)
+    links.push_back(std::make_pair((long)forest.ID(r),
+				   forest.Parent(r) >= 0 ? (long)forest.ID(forest.Parent(r)) : -1L));
+  std::sort(links.begin(),links.end());
+  return links;
+}
+
+// same, from the tree links of the nodes of a collection
+static std::vector< std::pair<long,long> > TreeLinks(const geotree::NodeCollection& coll){
+  std::map<long,long> parent;
+  for (auto const& id : coll.GetNodeIDs())
+    parent[id] = -1;
+  for (auto const& id : coll.GetNodeIDs())
+    for (auto const& c : coll.FindNode(id)->childrenID())
+      parent[c] = id;
+  return std::vector< std::pair<long,long> >(parent.begin(),parent.end());
+}
+
+// empty if the manager holds the best beam hypothesis
+static std::string CheckBeam(const Event& ev){
+  geotree::Manager mgr;
+  Load(mgr,ev);
+  geotree::BeamSearch beam(8,3);
+  std::vector<geotree::BeamHypothesis> res;
+  try{
+    res = beam.Resolve(mgr);
+  }
+  catch (std::exception&){
+    return "";
+  }
+  auto const best = TreeLinks(res[0].forest);
+  if (TreeLinks(mgr.LastForest()) != best)
+    return "LastForest is not the tree of the best hypothesis\n";
+  auto const published = mgr.GetForest();
+  if ( (!published) or (TreeLinks(*published) != best) )
+    return "published forest is not the tree of the best hypothesis\n";
+  if ( (mgr.LastForest().Event() != 1) or (published->Event() != 1) )
+    return "BeamSearch made " + std::to_string(mgr.LastForest().Event()) + " forests, not 1\n";
+  return "";
+}
+
+struct Engine {
+  const char* name;
+  Result (*run)(const Event&);
+  // engines that check themselves instead of being compared
+  // with the reference: empty if fine
+  std::string (*check)(const Event&);
+};
+
+static const Engine kEngines[] = {
+  {"manager",     RunManager,0},
+  {"reuse",       RunReuse,0},
+  {"snapshot",    RunSnapshot,0},
+  {"transaction", RunTransaction,0},
+  {"dominated",   RunDominated,0},
+  {"census-off",  RunCensusOff,0},
+  {"shuffle",     RunShuffle,0},
+  {"batch",       RunBatch,0},
+  {"lazy",        RunLazy,0},
+  {"beam",        0,CheckBeam},
+};
+
+// empty if res agrees with ref. Without forest, ref's MakeTree is
+// not compared (nor an exception the engine threw in MakeTree)
+static std::string Differ(const std::string& refName, const Result& ref, bool forest,
+			  const std::string& name, const Result& res){
+  // the engine threw in MakeTree (or failed, without saying where)
+  bool const treeError = (res.error.empty() == false) and
+    ( (res.hasResolved == false) or (res.resolved.empty() == false) );
+  if ( (forest == false) and ref.error.empty() and treeError ){
+    if ( res.hasResolved and (ref.resolved != res.resolved) )
+      return "resolved correlations\n--- " + refName + "\n" + ref.resolved + "--- " + name + "\n" + res.resolved;
+    return "";
+  }
+  if ( (ref.error.empty() == false) or (res.error.empty() == false) ){
+    if (res.error == "(failed)")
+      return ref.error.empty() ? name + " failed, " + refName + " did not\n" : "";
+    if (ref.error != res.error)
+      return "exception: " + refName + " [" + ref.error + "] " + name + " [" + res.error + "]\n";
+    return "";
+  }
+  if (res.hasResolved and (ref.resolved != res.resolved))
+    return "resolved correlations\n--- " + refName + "\n" + ref.resolved + "--- " + name + "\n" + res.resolved;
+  if (forest and (ref.forest != res.forest))
+    return "forest\n--- " + refName + "\n" + ref.forest + "--- " + name + "\n" + res.forest;
+  return "";
+}
+
+// empty if the engine agrees with the frozen reference (where
+// comparable) and, except for the manager engine, with a fresh Manager
+static std::string Compare(const Engine& engine, const Event& ev){
+  if (engine.check)
+    return engine.check(ev);
+  Result const res = engine.run(ev);
+  Frozen const frozen = RunFrozen(ev);
+  if (frozen.skipResolved.empty()){
+    std::string const diff = Differ("frozen",frozen.res,frozen.skipForest.empty(),engine.name,res);
+    if (diff.empty() == false)
+      return diff;
+  }
+  if (engine.run == RunManager)
+    return "";
+  return Differ("manager",RunManager(ev),true,engine.name,res);
+}
+
+static Event Subset(const Event& ev, const std::vector<bool>& keep){
+  Event out;
+  out.loose = ev.loose;
+  out.matching = ev.matching;
+  out.nodes = ev.nodes;
+  for (size_t i=0; i < ev.Size(); i++){
+    if (keep[i] == false) continue;
+    out.id1.push_back(ev.id1[i]);
+    out.id2.push_back(ev.id2[i]);
+    out.score.push_back(ev.score[i]);
+    out.type.push_back(ev.type[i]);
+    for (size_t k=0; k < 3; k++) out.vtx.push_back(ev.vtx[3*i+k]);
+  }
+  return out;
+}
+
+// smallest event (by removal of correlations, then of nodes
+// without correlations) on which the engine still differs
+static Event Shrink(const Engine& engine, Event ev){
+
+  // correlations: chunks of decreasing size
+  size_t chunk = ev.Size()/2;
+  while (chunk >= 1){
+    bool removed = false;
+    for (size_t start=0; start < ev.Size(); ){
+      std::vector<bool> keep(ev.Size(),true);
+      for (size_t i=start; i < std::min(start+chunk,ev.Size()); i++) keep[i] = false;
+      Event const cand = Subset(ev,keep);
+      if (Compare(engine,cand).empty() == false){
+	ev = cand;
+	removed = true;
+      }
+      else
+	start += chunk;
+    }
+    if ( (removed == false) or (chunk > ev.Size()) )
+      chunk /= 2;
+  }
+
+  // nodes that no correlation refers to
+  std::set<long> used(ev.id1.begin(),ev.id1.end());
+  used.insert(ev.id2.begin(),ev.id2.end());
+  for (size_t i=0; i < ev.nodes.size(); ){
+    if (used.count(ev.nodes[i])){ i++; continue; }
+    Event cand = ev;
+    cand.nodes.erase(cand.nodes.begin()+i);
+    if (Compare(engine,cand).empty() == false)
+      ev = cand;
+    else
+      i++;
+  }
+
+  return ev;
+}
+
+static void Print(const Event& ev){
+  static const char* kType[] = {"kParent","kChild","kSibling","kUnknown"};
+  std::cout << "  mgr.setLoose(" << (ev.loose ? "true" : "false") << ");" << std::endl;
+  if (ev.matching)
+    std::cout << "  mgr.setSiblingMatching(true);" << std::endl;
+  std::cout << "  std::vector<long> nodes = {";
+  for (size_t i=0; i < ev.nodes.size(); i++)
+    std::cout << (i ? "," : "") << ev.nodes[i];
+  std::cout << "};" << std::endl;
+  for (size_t i=0; i < ev.Size(); i++)
+    std::cout << "  mgr.AddCorrelation(" << ev.id1[i] << "," << ev.id2[i] << "," << Hex(ev.score[i])
+	      << ",::geoalgo::Point_t(" << Hex(ev.vtx[3*i]) << "," << Hex(ev.vtx[3*i+1]) << ","
+	      << Hex(ev.vtx[3*i+2]) << "),geotree::RelationType_t::" << kType[ev.type[i]] << ");" << std::endl;
+}
+
+// random event: generator fractions drawn per event, plus extra
+// correlations of random type between pairs not yet correlated
+static Event MakeEvent(std::mt19937& rand, size_t maxNodes){
+
+  std::uniform_real_distribution<double> u(0.,1.);
+  size_t const nodes = 2 + (size_t)(u(rand)*(maxNodes-1));
+
+  geotree::EventGenerator gen;
+  gen.SetSeed(rand());
+  gen.SetNodes(nodes);
+  gen.SetPrimaryFraction(0.5*u(rand));
+  gen.SetMultipleParentFraction(u(rand));
+  gen.SetParentSiblingFraction(u(rand));
+  gen.SetMultipleSiblingFraction(u(rand));
+  gen.SetCorrelationDensity(0.2*u(rand));
+  gen.Generate();
+
+  Event ev;
+  ev.loose = (u(rand) < 0.5);
+  ev.matching = false;
+  ev.nodes.assign(gen.GetNodeIDs().begin(),gen.GetNodeIDs().end());
+  std::set< std::pair<long,long> > pairs;
+  auto add = [&](long a, long b, double s, double x, double y, double z, int t){
+    ev.id1.push_back(a); ev.id2.push_back(b);
+    ev.score.push_back(s); ev.type.push_back(t);
+    ev.vtx.push_back(x); ev.vtx.push_back(y); ev.vtx.push_back(z);
+    pairs.insert(std::make_pair(std::min(a,b),std::max(a,b)));
+  };
+  for (auto const& c : gen.GetCorrelations())
+    add(c.id1,c.id2,c.score,c.vtx[0],c.vtx[1],c.vtx[2],(int)c.type);
+
+  size_t const extra = (size_t)(u(rand)*nodes/2);
+  for (size_t i=0; i < extra; i++){
+    long const a = ev.nodes[(size_t)(u(rand)*nodes) % nodes];
+    long const b = ev.nodes[(size_t)(u(rand)*nodes) % nodes];
+    if ( (a == b) or pairs.count(std::make_pair(std::min(a,b),std::max(a,b))) )
+      continue;
+    // scores on a coarse grid so that ties happen
+    add(a,b,0.1*(int)(u(rand)*10),u(rand)*100,u(rand)*100,u(rand)*100,(int)(u(rand)*3) % 3);
+  }
+
+  return ev;
+}
+
+// random event with sibling correlations only, at a few vertices
+// (multiple siblings at different vertices: the conflicts of the
+// sibling matching, and no other stage has work)
+static Event MakeSiblingEvent(std::mt19937& rand, size_t maxNodes){
+
+  std::uniform_real_distribution<double> u(0.,1.);
+  size_t const nodes = 2 + (size_t)(u(rand)*(maxNodes-1));
+  size_t const nVtx = 1 + (size_t)(u(rand)*4);
+  std::vector<double> vertices;
+  for (size_t v=0; v < 3*nVtx; v++)
+    vertices.push_back(u(rand)*100);
+  double const density = 3./nodes;
+
+  Event ev;
+  ev.loose = (u(rand) < 0.5);
+  ev.matching = false;
+  for (size_t i=0; i < nodes; i++)
+    ev.nodes.push_back(2*i);
+  for (size_t a=0; a < nodes; a++){
+    for (size_t b=a+1; b < nodes; b++){
+      if (u(rand) >= density) continue;
+      size_t const v = (size_t)(u(rand)*nVtx) % nVtx;
+      ev.id1.push_back(ev.nodes[a]); ev.id2.push_back(ev.nodes[b]);
+      // scores on a coarse grid so that ties happen
+      ev.score.push_back(0.1*(int)(u(rand)*10));
+      ev.type.push_back((int)geotree::RelationType_t::kSibling);
+      for (size_t k=0; k < 3; k++) ev.vtx.push_back(vertices[3*v+k]);
+    }
+  }
+
+  return ev;
+}
+
+int main(int argc, char** argv){
+
+  size_t nEvents  = 1000;
+  size_t maxNodes = 30;
+  unsigned int seed = 1;
+  bool shrink = true;
+  bool matching = false;
+  std::string only;
+
+  for (int i=1; i < argc; i++){
+    std::string arg = argv[i];
+    bool hasVal = (i+1 < argc);
+    if      (arg == "--no-shrink") { shrink = false; }
+    else if (arg == "--sibling-matching") { matching = true; }
+    else if (arg == "--events" && hasVal) { nEvents  = strtoul(argv[++i],0,10); }
+    else if (arg == "--nodes"  && hasVal) { maxNodes = strtoul(argv[++i],0,10); }
+    else if (arg == "--seed"   && hasVal) { seed     = strtoul(argv[++i],0,10); }
+    else if (arg == "--engine" && hasVal) { only     = argv[++i]; }
+    else{
+      std::cerr << "Unknown argument: " << arg << std::endl;
+      return 1;
+    }
+  }
+  if (maxNodes < 2) maxNodes = 2;
+
+  std::vector<Engine> engines;
+  for (auto const& e : kEngines)
+    if ( only.empty() or (only == e.name) ) engines.push_back(e);
+  if (engines.empty()){
+    std::cerr << "Unknown engine: " << only << std::endl;
+    return 1;
+  }
+
+  geotree::Logger::SetLevel(geotree::msg::kERROR);
+
+  std::mt19937 rand(seed);
+  std::vector<size_t> failures(engines.size(),0);
+  std::vector<bool> shrunk(engines.size(),false);
+  size_t exceptions = 0;
+  // events on which the frozen reference was not compared, by reason
+  std::map<std::string,size_t> skipped;
+  size_t frozenForests = 0;
+
+  for (size_t e=0; e < nEvents; e++){
+    // with sibling matching, one event in four exercises it alone
+    Event ev = (matching and (rand() % 4 == 0)) ? MakeSiblingEvent(rand,maxNodes) : MakeEvent(rand,maxNodes);
+    ev.matching = matching;
+    if (RunManager(ev).error.empty() == false) exceptions += 1;
+    Frozen const frozen = RunFrozen(ev);
+    if (frozen.skipForest.empty() == false)
+      skipped[frozen.skipForest] += 1;
+    else if (frozen.res.error.empty())
+      frozenForests += 1;
+    for (size_t k=0; k < engines.size(); k++){
+      std::string const diff = Compare(engines[k],ev);
+      if (diff.empty()) continue;
+      failures[k] += 1;
+      if (shrunk[k]) continue;
+      shrunk[k] = true;
+      std::cout << "engine " << engines[k].name << " differs on event " << e
+		<< " (seed " << seed << ", " << ev.nodes.size() << " nodes, "
+		<< ev.Size() << " correlations)" << std::endl;
+      Event const minimal = shrink ? Shrink(engines[k],ev) : ev;
+      std::cout << "minimal event (" << minimal.nodes.size() << " nodes, "
+		<< minimal.Size() << " correlations):" << std::endl;
+      Print(minimal);
+      std::cout << Compare(engines[k],minimal);
+    }
+  }
+
+  int status = 0;
+  std::cout << "events " << nEvents << " (manager threw on " << exceptions << ")" << std::endl;
+  std::cout << "frozen reference: forest compared on " << frozenForests << " events";
+  for (auto const& s : skipped)
+    std::cout << ", not on " << s.second << " (" << s.first << ")";
+  std::cout << std::endl;
+  for (size_t k=0; k < engines.size(); k++){
+    std::cout << engines[k].name << ": " << failures[k] << " differing events" << std::endl;
+    if (failures[k] > 0) status = 1;
+  }
+
+  return status;
+}
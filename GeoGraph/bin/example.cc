@@ -1,15 +1,27 @@
 //
-// Example C++ routine to run instantiate your sample class
+// Example C++ routine: build a small event and make the tree
 //
 
-#include "GeoGraph/sample.h"
+#include "GeoGraph/Manager.h"
 #include <iostream>
 
 int main(int argc, char** argv){
 
-   sample my_clss_object;
+  geotree::Manager mgr;
 
-   std::cout << "Hello World with My Object!" << std::endl;    
+  // nodes get IDs 0, 2, 4, 6
+  mgr.setObjects(4);
+
+  // 0 is parent of 2 and 4. 4 and 6 are siblings
+  mgr.AddCorrelation(0,2,0.9,::geoalgo::Point_t(0.,0.,0.),::geotree::RelationType_t::kParent);
+  mgr.AddCorrelation(0,4,0.8,::geoalgo::Point_t(0.,0.,0.),::geotree::RelationType_t::kParent);
+  mgr.AddCorrelation(4,6,0.5,::geoalgo::Point_t(1.,1.,1.),::geotree::RelationType_t::kSibling);
+
+  mgr.ResolveConflicts();
+  mgr.MakeTree();
+
+  mgr.CorrelationMatrix();
+  mgr.Diagram();
 
   return 0;
 }
@@ -0,0 +1,93 @@
+//
+// Streaming mode example for geotree::Pipeline
+// Synthetic events (geotree::EventGenerator) are processed once
+// sequentially with a single Manager and once through the stage
+// pipeline. Throughput of both and the per-stage queue metrics
+// of the pipeline are printed.
+//
+// Usage: pipeline [--nodes N] [--events N] [--buffers N] [--seed S] [--loose]
+//
+
+#include "GeoGraph/EventGenerator.h"
+#include "GeoGraph/Pipeline.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+typedef std::chrono::steady_clock Clock_t;
+
+int main(int argc, char** argv){
+
+  size_t nNodes   = 1000;
+  size_t nEvents  = 200;
+  size_t nBuffers = 8;
+  unsigned int seed = 1;
+  bool loose      = false;
+
+  for (int i=1; i < argc; i++){
+    std::string arg = argv[i];
+    bool hasVal = (i+1 < argc);
+    if      (arg == "--loose") { loose = true; }
+    else if (arg == "--nodes"   && hasVal) { nNodes   = strtoul(argv[++i],0,10); }
+    else if (arg == "--events"  && hasVal) { nEvents  = strtoul(argv[++i],0,10); }
+    else if (arg == "--buffers" && hasVal) { nBuffers = strtoul(argv[++i],0,10); }
+    else if (arg == "--seed"    && hasVal) { seed     = strtoul(argv[++i],0,10); }
+    else{
+      std::cerr << "Unknown argument: " << arg << std::endl;
+      return 1;
+    }
+  }
+
+  size_t nErrors = 0;
+
+  // sequential reference
+  geotree::EventGenerator gen;
+  gen.SetSeed(seed);
+  gen.SetNodes(nNodes);
+
+  geotree::Manager mgr;
+  mgr.setLoose(loose);
+
+  auto start = Clock_t::now();
+  for (size_t e=0; e < nEvents; e++){
+    gen.Generate();
+    gen.Fill(mgr);
+    try{
+      mgr.ResolveConflicts();
+      mgr.MakeTree();
+    }
+    catch (std::exception& ex){
+      nErrors += 1;
+    }
+  }
+  double seq = std::chrono::duration<double>(Clock_t::now()-start).count();
+  std::cout << "sequential: " << nEvents << " events (" << nErrors << " errors) in " << seq << " s -> "
+	    << nEvents/seq << " events/s" << std::endl;
+
+  // same events through the pipeline
+  gen.SetSeed(seed);
+  nErrors = 0;
+
+  geotree::Pipeline pipe(nBuffers);
+  pipe.Configure([loose](geotree::Manager& m){ m.setLoose(loose); });
+  pipe.SetIngest([&](geotree::Manager& m, size_t evt){
+      if (evt == nEvents) return false;
+      gen.Generate();
+      gen.Fill(m);
+      return true;
+    });
+  pipe.SetOutput([&](geotree::Pipeline::Event& ev){
+      if (!ev.ok) nErrors += 1;
+    });
+
+  start = Clock_t::now();
+  size_t n = pipe.Run();
+  double par = std::chrono::duration<double>(Clock_t::now()-start).count();
+  std::cout << "pipeline:   " << n << " events (" << nErrors << " errors) in " << par << " s -> "
+	    << n/par << " events/s" << std::endl;
+
+  pipe.Print(std::cout);
+
+  return 0;
+}
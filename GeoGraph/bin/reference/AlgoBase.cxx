@@ -0,0 +1,11 @@
+#ifndef REF_ALGOBASE_CXX
+#define REF_ALGOBASE_CXX
+
+#include "AlgoBase.h"
+
+namespace geotree_ref{
+
+
+}
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef REF_ALGOMULTIPLEPARENTSBASE_CXX
+#define REF_ALGOMULTIPLEPARENTSBASE_CXX
+
+#include "AlgoMultipleParentsBase.h"
+
+#endif
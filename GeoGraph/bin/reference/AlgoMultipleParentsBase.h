@@ -0,0 +1,36 @@
+/**
+ * \file AlgoMultipleParentsBase.h
+ *
+ * \ingroup GeoTree
+ * 
+ * \brief Class def header for a class geotree_ref::AlgoMultipleParentsBase
+ *
+ * @author david caratelli
+ */
+
+/** \addtogroup GeoTree
+    
+    @{*/
+#ifndef REF_ALGOMULTIPLEPARENTSBASE_H
+#define REF_ALGOMULTIPLEPARENTSBASE_H
+
+#include "AlgoBase.h"
+
+namespace geotree_ref{
+
+  class AlgoMultipleParentsBase : public AlgoBase {
+
+  public:
+    
+    AlgoMultipleParentsBase() { _name="MultipleParents"; }
+
+    /// Constructor which syncs node collection for the algorithm
+    AlgoMultipleParentsBase(NodeCollection* coll) { _name="MultipleParents"; _coll = coll; _verbose = false; }
+
+    virtual void FindBestParent(const NodeID_t& id, const std::vector<NodeID_t>& parents) {}
+
+  };
+}
+
+#endif
+/** @} */ // end of doxygen group 
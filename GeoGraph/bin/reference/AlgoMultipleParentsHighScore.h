@@ -0,0 +1,45 @@
+/**
+ * \file AlgoMultipleParentsHighScore.h
+ *
+ * \ingroup GeoTree
+ * 
+ * \brief Class def header for a class geotree_ref::AlgoMultipleParentsHighScore
+ *
+ * @author david caratelli
+ */
+
+/** \addtogroup GeoTree
+    This algorithm is called when a node was found to
+    have multiple parents.
+    Actions taken:
+    The correlation with the parent with the highest
+    score is retained. All other parent correlations
+    are removed. No check on other correlations with
+    other nodes are performed.
+    @{*/
+
+#ifndef REF_ALGOMULTIPLEPARENTSHIGHSCORE_H
+#define REF_ALGOMULTIPLEPARENTSHIGHSCORE_H
+
+#include "AlgoMultipleParentsBase.h"
+//#include "AlgoBase.h"
+
+namespace geotree_ref{
+
+  class AlgoMultipleParentsHighScore : public AlgoMultipleParentsBase {
+
+  public:
+
+    
+    AlgoMultipleParentsHighScore() { _name="MultipleParentsHighScore"; }
+
+    /// Constructor which syncs node collection for the algorithm
+    AlgoMultipleParentsHighScore(NodeCollection* coll);
+
+    void FindBestParent(const NodeID_t& id, const std::vector<NodeID_t>& parents);
+
+  };
+}
+
+#endif
+/** @} */ // end of doxygen group 
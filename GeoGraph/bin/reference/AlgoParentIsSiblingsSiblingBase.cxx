@@ -0,0 +1,22 @@
+#ifndef REF_ALGOPARENTISSIBLINGSSIBLINGBASE_CXX
+#define REF_ALGOPARENTISSIBLINGSSIBLINGBASE_CXX
+
+#include "AlgoParentIsSiblingsSiblingBase.h"
+
+namespace geotree_ref{
+
+  AlgoParentIsSiblingsSiblingBase::AlgoParentIsSiblingsSiblingBase(NodeCollection *coll)
+  {
+    _coll = coll;
+    _name = "ParentIsSiblingsSiblingBase";
+  }
+
+  void AlgoParentIsSiblingsSiblingBase::ResolveConflict(const NodeID_t& id, const NodeID_t& parent, const NodeID_t& sibling)
+  {
+
+    return;
+  }
+
+}
+
+#endif
@@ -0,0 +1,42 @@
+/**
+ * \file AlgoParentIsSiblingsSiblingBase.h
+ *
+ * \ingroup GeoTree
+ * 
+ * \brief Class def header for a class geotree_ref::AlgoParentIsSiblingsSiblingBase
+ *
+ * @author david caratelli
+ */
+
+/** \addtogroup GeoTree
+    This algorithm is called when a node is found
+    to have a parent and a sibling that are siblings
+    with each other.
+    Actions taken:
+    None : Base Class
+    @{*/
+
+#ifndef REF_ALGOPARENTISSIBLINGSSIBLINGBASE_H
+#define REF_ALGOPARENTISSIBLINGSSIBLINGBASE_H
+
+//#include "AlgoMultipleParentsBase.h"
+#include "AlgoBase.h"
+
+namespace geotree_ref{
+
+  class AlgoParentIsSiblingsSiblingBase : public AlgoBase {
+
+  public:
+    
+    AlgoParentIsSiblingsSiblingBase() { _name="ParentIsSiblingsSiblingBase"; }
+
+    /// Constructor which syncs node collection for the algorithm
+    AlgoParentIsSiblingsSiblingBase(NodeCollection* coll);
+
+    virtual void ResolveConflict(const NodeID_t& id, const NodeID_t& parent, const NodeID_t& sibling);
+
+  };
+}
+
+#endif
+/** @} */ // end of doxygen group 
@@ -0,0 +1,27 @@
+#ifndef REF_CORRELATION_CXX
+#define REF_CORRELATION_CXX
+
+#include "Correlation.h"
+
+namespace geotree_ref{
+
+  Correlation::Correlation(double s, ::geoalgo::Point_t vtx,
+			   ::geotree_ref::RelationType_t type)
+  {
+    _score = s;
+    _vtx   = vtx;
+    _type  = type;
+  }
+
+  void Correlation::EditCorrelation(double s, ::geoalgo::Point_t vtx,
+			   ::geotree_ref::RelationType_t type)
+  {
+    _score = s;
+    _vtx   = vtx;
+    _type  = type;
+  }
+
+
+}
+
+#endif
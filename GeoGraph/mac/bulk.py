@@ -0,0 +1,124 @@
+#
+# NumPy helpers for the bulk interface of geotree::Manager
+# (LoadArrays / FillForestArrays / ResolveBatch).
+#
+# Whole events go in and whole forests come out as NumPy arrays:
+# PyROOT hands the array buffers to C++ as pointers, so there is
+# one call per event (or per batch) and no per-element copy.
+# Inputs are only converted (copied) if their dtype or memory
+# layout does not match the one expected by C++.
+#
+# Usage:
+#   mgr = geotree.Manager()
+#   f = resolve_event(mgr, id1, id2, score, vtx, rel)
+#   print f['id'], f['parent'], f['depth'], f['vtx']
+#
+import sys
+import numpy as np
+import ROOT
+from ROOT import gSystem
+gSystem.Load("libTreeGraph_GeoGraph")
+from ROOT import geotree
+
+ID_T    = np.int64    # node IDs, rows, offsets (C++ long)
+SCORE_T = np.float64  # scores and vertices (C++ double)
+TYPE_T  = np.int32    # relation types and depths (C++ int)
+
+def _in(a, dtype):
+    return np.ascontiguousarray(a, dtype=dtype)
+
+def _ptr(a):
+    if a is None:
+        return ROOT.nullptr
+    return a
+
+def _correlations(id1, id2, score, vtx, rel):
+    id1   = _in(id1, ID_T)
+    id2   = _in(id2, ID_T)
+    score = _in(score, SCORE_T)
+    vtx   = _in(vtx, SCORE_T).reshape(-1, 3)
+    rel   = _in(rel, TYPE_T)
+    n = len(id1)
+    if not (len(id2) == n and len(score) == n and len(vtx) == n and len(rel) == n):
+        raise ValueError("correlation arrays must all have the same length")
+    return id1, id2, score, vtx, rel
+
+def load_event(mgr, id1, id2, score, vtx, rel, nodes=None):
+    """Reset the manager and load one event.
+    id1, id2, score, rel: shape (N,). vtx: shape (N,3).
+    rel: geotree.kParent, kChild, kSibling or kUnknown (id2 w.r.t. id1).
+    nodes: node IDs in the order they should be made
+    (default: the IDs of the correlations, sorted)."""
+    id1, id2, score, vtx, rel = _correlations(id1, id2, score, vtx, rel)
+    if nodes is not None:
+        nodes = _in(nodes, ID_T)
+    nnodes = 0 if nodes is None else len(nodes)
+    return mgr.LoadArrays(nnodes, _ptr(nodes), len(id1), id1, id2, score, vtx, rel)
+
+def forest(mgr):
+    """Forest made by the last MakeTree, one row per node:
+    id, parent (row of the parent, -1 for head nodes),
+    depth (0 for head nodes), vtx (N,3; NaN where unknown).
+    The arrays are empty if there is no forest."""
+    n = max(mgr.NodeCount(), mgr.LastForest().Size())
+    out = { 'id'     : np.empty(n, dtype=ID_T),
+            'parent' : np.empty(n, dtype=ID_T),
+            'depth'  : np.empty(n, dtype=TYPE_T),
+            'vtx'    : np.empty((n, 3), dtype=SCORE_T) }
+    rows = mgr.FillForestArrays(n, out['id'], out['parent'], out['depth'], out['vtx'])
+    for k in ('id', 'parent', 'depth', 'vtx'):
+        out[k] = out[k][:rows]
+    return out
+
+def resolve_event(mgr, id1, id2, score, vtx, rel, nodes=None):
+    """Load one event, resolve it, make the tree and return the forest."""
+    load_event(mgr, id1, id2, score, vtx, rel, nodes)
+    mgr.ResolveConflicts()
+    mgr.MakeTree()
+    return forest(mgr)
+
+def resolve_batch(mgr, offsets, id1, id2, score, vtx, rel,
+                  node_offsets=None, nodes=None):
+    """Resolve several events in one call.
+    Correlations of event e: rows offsets[e]:offsets[e+1].
+    Node IDs of event e (optional): nodes[node_offsets[e]:node_offsets[e+1]].
+    Returns the forest arrays of all events concatenated, with
+    'offsets' (rows of event e: offsets[e]:offsets[e+1], parent rows
+    relative to the event) and 'ok' (0 for events that failed)."""
+    offsets = _in(offsets, ID_T)
+    id1, id2, score, vtx, rel = _correlations(id1, id2, score, vtx, rel)
+    nev = len(offsets) - 1
+    if nodes is not None:
+        nodes = _in(nodes, ID_T)
+        node_offsets = _in(node_offsets, ID_T)
+        capacity = 2*len(nodes)
+    else:
+        capacity = 4*len(id1)
+    out = { 'id'      : np.empty(capacity, dtype=ID_T),
+            'parent'  : np.empty(capacity, dtype=ID_T),
+            'depth'   : np.empty(capacity, dtype=TYPE_T),
+            'vtx'     : np.empty((capacity, 3), dtype=SCORE_T),
+            'offsets' : np.empty(nev+1, dtype=ID_T),
+            'ok'      : np.empty(nev, dtype=TYPE_T) }
+    rows = mgr.ResolveBatch(nev, _ptr(node_offsets), _ptr(nodes),
+                            offsets, id1, id2, score, vtx, rel,
+                            capacity, out['id'], out['parent'], out['depth'], out['vtx'],
+                            out['offsets'], out['ok'])
+    for k in ('id', 'parent', 'depth', 'vtx'):
+        out[k] = out[k][:rows]
+    return out
+
+if __name__ == '__main__':
+
+    # same event as bin/example.cc
+    mgr = geotree.Manager()
+    f = resolve_event(mgr,
+                      id1   = [0, 0, 4],
+                      id2   = [2, 4, 6],
+                      score = [0.9, 0.8, 0.5],
+                      vtx   = [[0., 0., 0.], [0., 0., 0.], [1., 1., 1.]],
+                      rel   = [geotree.kParent, geotree.kParent, geotree.kSibling])
+    for i in xrange(len(f['id'])):
+        print f['id'][i], f['parent'][i], f['depth'][i], f['vtx'][i]
+
+    sys.exit(0)